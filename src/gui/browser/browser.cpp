@@ -31,7 +31,10 @@ Browser::Browser(QWidget *parent, LocationBar *locationBar, SearchBar *searchBar
     m_filesMenu(nullptr),
     m_packagesToolbar(new QToolBar(this)),
     m_filesToolbar(new QToolBar(this)),
-    m_loaded(false)
+    m_loaded(false),
+    m_projectListLoaded(false),
+    m_packageToken(0),
+    m_downloadProgress(-1)
 {
     ui->setupUi(this);
 
@@ -53,7 +56,14 @@ Browser::Browser(QWidget *parent, LocationBar *locationBar, SearchBar *searchBar
     ui->tabWidget->setTabVisible(1, false);
     ui->tabWidget->setTabVisible(2, false);
 
+    connect(m_obs, &OBS::projectsFetched, m_locationBar, &LocationBar::addPartialProjectList);
     connect(m_obs, &OBS::finishedParsingProjectList, this, &Browser::addProjectList);
+    connect(m_obs, &OBS::staleDataLoaded, this, [this]() {
+        emit updateStatusBar(tr("Showing cached data, updating..."), false);
+    });
+    connect(m_obs, &OBS::dataRevalidated, this, [this]() {
+        emit updateStatusBar(tr("Done"), true);
+    });
     connect(m_locationBar, &LocationBar::projectChanged, this, &Browser::load);
     connect(m_locationBar, &LocationBar::returnPressed, this, &Browser::load);
 
@@ -63,18 +73,19 @@ Browser::Browser(QWidget *parent, LocationBar *locationBar, SearchBar *searchBar
     connect(m_obs, &OBS::finishedParsingPackageSearch, m_searchBar, &SearchBar::loadSearchResults);
      connect(m_searchBar, &SearchBar::returnPressed, this, &Browser::goTo);
 
-    connect(m_obs, &OBS::finishedParsingFile, this, &Browser::addFile);
+    connect(m_obs, &OBS::finishedParsingFiles, this, &Browser::addFiles);
     connect(m_obs, &OBS::finishedParsingFileList, ui->filesWidget, &FileTreeWidget::onFilesAdded);
     connect(m_obs, &OBS::finishedParsingUploadFileRevision, this, &Browser::onUploadFile);
     connect(m_obs, &OBS::cannotUploadFile, this, &Browser::onUploadFileError);
-    connect(m_obs, &OBS::fileFetched, this, &Browser::onFileFetched);
+    connect(m_obs, &OBS::uploadProgress, this, &Browser::onUploadProgress);
+    connect(m_obs, &OBS::fileDownloaded, this, &Browser::onFileDownloaded);
+    connect(m_obs, &OBS::downloadProgress, this, &Browser::onDownloadProgress);
     connect(ui->filesWidget, &FileTreeWidget::updateStatusBar, this, &Browser::updateStatusBar);
 
     connect(m_obs, &OBS::finishedParsingCreateRequest, this, &Browser::onRequestCreated);
     connect(m_obs, &OBS::finishedParsingCreateRequestStatus, this, &Browser::slotCreateRequestStatus);
     connect(m_obs, &OBS::finishedParsingBranchPackage, this, &Browser::onPackageBranched);
 
-    connect(m_obs, &OBS::buildLogFetched, this, &Browser::onBuildLogFetched);
     connect(m_obs, &OBS::buildLogNotFound, this, &Browser::onBuildLogNotFound);
     connect(m_obs, &OBS::projectNotFound, this, &Browser::onProjectNotFound);
     connect(m_obs, &OBS::projectNotFound, ui->overviewWidget, &OverviewWidget::onProjectNotFound);
@@ -121,7 +132,7 @@ Browser::Browser(QWidget *parent, LocationBar *locationBar, SearchBar *searchBar
     connect(m_obs, &OBS::finishedParsingPackageList, this, &Browser::slotSelectPackage);
     connect(ui->packagesWidget, &PackageTreeWidget::updateStatusBar, this, &Browser::updateStatusBar);
 
-    connect(m_obs, &OBS::finishedParsingResult, this, &Browser::addResult);
+    connect(m_obs, &OBS::finishedParsingResults, this, &Browser::addResults);
     connect(m_obs, &OBS::finishedParsingResultList, ui->overviewWidget, &OverviewWidget::finishedParsingResultList);
     connect(m_obs, &OBS::finishedParsingResultList, this, &Browser::onResultsAdded);
 
@@ -140,11 +151,11 @@ Browser::Browser(QWidget *parent, LocationBar *locationBar, SearchBar *searchBar
 
     connect(ui->tabWidget, &QTabWidget::currentChanged, this, &Browser::onTabIndexChanged);
 
-    connect(m_obs, &OBS::finishedParsingRevision, ui->revisionsWidget, &RevisionTreeWidget::addRevision);
+    connect(m_obs, &OBS::finishedParsingRevisions, ui->revisionsWidget, &RevisionTreeWidget::addRevisions);
     connect(m_obs, &OBS::finishedParsingRevisionList, ui->revisionsWidget, &RevisionTreeWidget::revisionsAdded);
     connect(ui->revisionsWidget, &RevisionTreeWidget::updateStatusBar, this, &Browser::updateStatusBar);
 
-    connect(m_obs, &OBS::finishedParsingRequest, ui->requestsWidget, &RequestsWidget::addRequest);
+    connect(m_obs, &OBS::finishedParsingRequests, ui->requestsWidget, &RequestsWidget::addRequests);
     connect(m_obs, &OBS::finishedParsingRequestList, ui->requestsWidget, &RequestsWidget::requestsAdded);
     connect(ui->requestsWidget, &RequestsWidget::updateStatusBar, this, &Browser::updateStatusBar);
 
@@ -180,8 +191,12 @@ void Browser::addProjectList(const QStringList &projectList)
     qDebug() << __PRETTY_FUNCTION__;
     m_locationBar->addProjectList(projectList);
 
-    emit toggleBookmarkActions("");
-    emit finishedLoadingProjects();
+    // The list can be delivered twice (cached, then updated)
+    if (!m_projectListLoaded) {
+        m_projectListLoaded = true;
+        emit toggleBookmarkActions("");
+        emit finishedLoadingProjects();
+    }
     emit updateStatusBar(tr("Done"), true);
 }
 
@@ -318,18 +333,13 @@ void Browser::reloadFiles()
     emit packageSelectionChanged();
 }
 
-void Browser::addResult(QSharedPointer<OBSResult> result)
+void Browser::addResults(const OBSResultSet &resultSet)
 {
     qDebug() << __PRETTY_FUNCTION__;
 
-    if (!result->getStatusList().isEmpty()) {
+    if (!resultSet.isEmpty()) {
         currentPackage = ui->packagesWidget->getCurrentPackage();
-        QString resultProject = result->getProject();
-        QString resultPackage = result->getStatusList().first()->getPackage();
-
-        if (currentProject == resultProject && currentPackage == resultPackage) {
-            ui->overviewWidget->addResult(result);
-        }
+        ui->overviewWidget->addResults(resultSet, currentProject, currentPackage);
     }
 }
 
@@ -347,7 +357,14 @@ void Browser::getBuildLog()
     QString currentBuildArch = ui->overviewWidget->getCurrentArch();
     QString currentPackage = ui->packagesWidget->getCurrentPackage();
 
-    m_obs->getBuildLog(currentProject, currentBuildRepository, currentBuildArch, currentPackage);
+    // The viewer follows the log while the build is running
+    BuildLogViewer *buildLogViewer = new BuildLogViewer(this);
+    buildLogViewer->setAttribute(Qt::WA_DeleteOnClose, true);
+    connect(buildLogViewer, &BuildLogViewer::logLoaded, this, [this]() {
+        emit updateStatusBar(tr("Done"), true);
+    });
+    buildLogViewer->show();
+    buildLogViewer->followLog(m_obs, currentProject, currentBuildRepository, currentBuildArch, currentPackage);
     emit updateStatusBar(tr("Getting build log..."), false);
 }
 
@@ -377,8 +394,11 @@ void Browser::getProjects()
     m_locationBar->clear();
     ui->overviewWidget->clear();
     currentProject = "";
+    m_projectListLoaded = false;
     emit projectSelectionChanged();
 
+// The project list is kept in the response cache; its cached copy
+// fills the project index right away (see OBSCore::getProjects())
     emit updateStatusBar(tr("Getting projects..."), false);
     m_obs->getProjects();
 }
@@ -412,6 +432,7 @@ void Browser::load(const QString &location)
         return;
     }
 
+    cancelPackageRequests();
     currentProject = getLocationProject();
     currentPackage = getLocationPackage();
     getPackages(currentProject);
@@ -460,6 +481,7 @@ void Browser::handlePackageTasks()
     QString prj = getLocationProject();
     QString pkg = getLocationPackage();
 
+    m_obs->setCancellationToken(m_packageToken);
     switch (tabIndex) {
         case 0:
             ui->overviewWidget->clear();
@@ -479,6 +501,7 @@ void Browser::handlePackageTasks()
             getPackageRequests(prj, pkg);
             break;
     }
+    m_obs->setCancellationToken(0);
 }
 
 void Browser::slotSelectedPackageNotFound(const QString &package)
@@ -493,11 +516,15 @@ void Browser::downloadFile()
 {
     QString currentPackage = ui->packagesWidget->getCurrentPackage();
     QString currentFile = ui->filesWidget->getCurrentFile();
-    m_downloadPath = QFileDialog::getSaveFileName(this, tr("Save as"), currentFile);
+    QString path = QFileDialog::getSaveFileName(this, tr("Save as"), currentFile);
+    if (path.isEmpty()) {
+        return;
+    }
     QString message = QString(tr("Downloading %1/%2/%3...")).arg(currentProject,
                                                              currentPackage, currentFile);
     emit updateStatusBar(message, false);
-    m_obs->downloadFile(currentProject, currentPackage, currentFile);
+    m_downloadProgress = -1;
+    m_obs->downloadFile(currentProject, currentPackage, currentFile, path);
 }
 
 void Browser::uploadSelectedFile()
@@ -712,11 +739,19 @@ void Browser::onProjectSelectionChanged()
     }
 }
 
+void Browser::cancelPackageRequests()
+{
+// Drop the queued/running requests of the package the user is leaving
+    m_obs->cancelRequests(m_packageToken);
+    m_packageToken = m_obs->createCancellationToken();
+}
+
 void Browser::onPackageSelectionChanged(const QItemSelection &selected, const QItemSelection &deselected)
 {
     qDebug() << Q_FUNC_INFO;
     Q_UNUSED(deselected)
 
+    cancelPackageRequests();
     ui->overviewWidget->setDataLoaded(false);
     ui->filesWidget->clearModel();
     ui->revisionsWidget->clearModel();
@@ -730,6 +765,7 @@ void Browser::onPackageSelectionChanged(const QItemSelection &selected, const QI
         currentPackage = selectedIndex.data().toString();
         m_locationBar->setText(currentProject + "/" + currentPackage);
 
+        m_obs->setCancellationToken(m_packageToken);
         switch (ui->tabWidget->currentIndex()) {
             case 0:
                 m_obs->getPackageMetaConfig(currentProject, currentPackage);
@@ -750,6 +786,7 @@ void Browser::onPackageSelectionChanged(const QItemSelection &selected, const QI
             default:
                 break;
         }
+        m_obs->setCancellationToken(0);
 
         emit packageSelectionChanged();
         ui->filesWidget->setAcceptDrops(true);
@@ -853,16 +890,21 @@ void Browser::slotContextMenuFiles(const QPoint &point)
     }
 }
 
-void Browser::addFile(QSharedPointer<OBSFile> file)
+void Browser::addFiles(QList<QSharedPointer<OBSFile>> fileList)
 {
-    qDebug() << __PRETTY_FUNCTION__;
+    qDebug() << __PRETTY_FUNCTION__ << fileList.size();
+
+    if (fileList.isEmpty()) {
+        return;
+    }
 
+    // All the files of a list belong to the same package
     currentPackage = ui->packagesWidget->getCurrentPackage();
-    QString fileProject = file->getProject();
-    QString filePackage = file->getPackage();
+    QString fileProject = fileList.first()->getProject();
+    QString filePackage = fileList.first()->getPackage();
 
     if (currentProject == fileProject && currentPackage == filePackage) {
-        ui->filesWidget->addFile(file);
+        ui->filesWidget->addFiles(fileList);
     }
 }
 
@@ -873,18 +915,19 @@ void Browser::uploadFile(const QString &path)
     QString package = ui->packagesWidget->getCurrentPackage();
 
     if (!currentProject.isEmpty() && !package.isEmpty()) {
-        QFile file(path);
-        if (!file.open(QIODevice::ReadOnly)) {
+        QFileInfo fi(path);
+        QString fileName = fi.fileName();
+        QString upload = currentProject + "/" + package + "/" + fileName;
+
+        // Dropping a file which is still being uploaded starts it over
+        int oldToken = m_uploads.take(upload);
+        m_obs->cancelRequests(oldToken);
+        m_uploadProgress.remove(oldToken);
+        int token = m_obs->uploadFile(currentProject, package, fileName, path);
+        if (token == 0) {
             return;
         }
-
-        QByteArray data = file.readAll();
-        qDebug() << __PRETTY_FUNCTION__ << "data.size()" << data.size();
-
-        QFileInfo fi(file.fileName());
-        QString fileName = fi.fileName();
-
-        m_obs->uploadFile(currentProject, package, fileName, data);
+        m_uploads.insert(upload, token);
 
         QString statusText = tr("Uploading %1 to %2/%3...").arg(fileName, currentProject, package);
         emit updateStatusBar(statusText, false);
@@ -893,10 +936,26 @@ void Browser::uploadFile(const QString &path)
     }
 }
 
+void Browser::onUploadProgress(int token, const QString &fileName, qint64 bytesSent, qint64 bytesTotal)
+{
+    // Uploads which have been started over report until they are aborted
+    if (bytesTotal <= 0 || !m_uploads.values().contains(token)) {
+        return;
+    }
+
+    int progress = int(bytesSent * 100 / bytesTotal);
+    if (progress != m_uploadProgress.value(token, -1)) {
+        m_uploadProgress.insert(token, progress);
+        emit updateStatusBar(tr("Uploading %1 (%2%)...").arg(fileName).arg(progress), false);
+    }
+}
+
 void Browser::onUploadFile(QSharedPointer<OBSRevision> revision)
 {
     qDebug() << __PRETTY_FUNCTION__;
     QString currentPackage = ui->packagesWidget->getCurrentPackage();
+    int token = m_uploads.take(revision->getProject() + "/" + revision->getPackage() + "/" + revision->getFile());
+    m_uploadProgress.remove(token);
 
     // Refresh file list
     if (currentProject == revision->getProject() && currentPackage == revision->getPackage()) {
@@ -904,12 +963,24 @@ void Browser::onUploadFile(QSharedPointer<OBSRevision> revision)
     }
     emit showTrayMessage(APP_NAME, tr("The file %1 has been uploaded").arg(revision->getFile()));
 
-    emit updateStatusBar(tr("Done"), true);
+    if (m_uploads.isEmpty()) {
+        emit updateStatusBar(tr("Done"), true);
+    }
 }
 
 void Browser::onUploadFileError(QSharedPointer<OBSStatus> status)
 {
     qDebug() << __PRETTY_FUNCTION__ << status->getCode();
+    QString prefix = status->getProject() + "/" + status->getPackage() + "/";
+    for (auto it = m_uploads.begin(); it != m_uploads.end();) {
+        if (it.key().startsWith(prefix)) {
+            m_uploadProgress.remove(it.value());
+            it = m_uploads.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
     QString title = tr("Warning");
     QString text = status->getSummary() + "<br>" + status->getDetails();
     QMessageBox::warning(this, title, text);
@@ -957,27 +1028,25 @@ void Browser::onPackageBranched(QSharedPointer<OBSStatus> status)
     emit updateStatusBar(tr("Done"), true);
 }
 
-void Browser::onFileFetched(const QString &fileName, const QByteArray &data)
+void Browser::onFileDownloaded(const QString &fileName, const QString &path)
 {
-    QFile file(m_downloadPath);
-    file.open(QIODevice::WriteOnly);
-    qint64 bytesWritten = file.write(data);
-    file.close();
-
-    if (bytesWritten != -1) {
-        emit showTrayMessage(APP_NAME, tr("File %1 downloaded successfuly").arg(fileName));
-    }
+    qDebug() << __PRETTY_FUNCTION__ << fileName << path;
+    emit showTrayMessage(APP_NAME, tr("File %1 downloaded successfuly").arg(fileName));
     emit updateStatusBar(tr("Done"), true);
 }
 
-void Browser::onBuildLogFetched(const QString &buildLog)
+void Browser::onDownloadProgress(const QString &fileName, qint64 bytesReceived, qint64 bytesTotal)
 {
-    qDebug() << __PRETTY_FUNCTION__;
-    BuildLogViewer *buildLogViewer = new BuildLogViewer(this);
-    buildLogViewer->show();
-    buildLogViewer->setText(buildLog);
-    buildLogViewer->setAttribute(Qt::WA_DeleteOnClose, true);
-    emit updateStatusBar(tr("Done"), true);
+    if (bytesTotal <= 0) {
+        return;
+    }
+
+    // Only update the status bar when the percentage changes
+    int progress = int(bytesReceived * 100 / bytesTotal);
+    if (progress != m_downloadProgress) {
+        m_downloadProgress = progress;
+        emit updateStatusBar(tr("Downloading %1 (%2%)...").arg(fileName).arg(progress), false);
+    }
 }
 
 void Browser::onBuildLogNotFound()
@@ -1075,4 +1144,5 @@ void Browser::onFileDeleted(QSharedPointer<OBSStatus> status)
 void Browser::onResultsAdded()
 {
    qDebug() << Q_FUNC_INFO;
+   emit updateStatusBar(tr("Done"), true);
 }
@@ -21,6 +21,7 @@
 #include <QMenu>
 #include <QToolBar>
 #include <QSharedPointer>
+#include <QHash>
 #include "locationbar.h"
 #include "searchbar.h"
 #include "metaconfigeditor.h"
@@ -61,7 +62,7 @@ public slots:
     void editPackage();
     void reloadPackages();
     void reloadFiles();
-    void addResult(QSharedPointer<OBSResult> result);
+    void addResults(const OBSResultSet &resultSet);
     void reloadResults();
     void getBuildLog();
     void branchSelectedPackage();
@@ -92,6 +93,7 @@ private:
     void getProjectRequests(const QString &project);
     void getPackageRequests(const QString &project, const QString &package);
     void launchMetaConfigEditor(const QString &project, const QString &package, MCEMode mode);
+    void cancelPackageRequests();
     Ui::Browser *ui;
     LocationBar *m_locationBar;
     SearchBar *m_searchBar;
@@ -108,8 +110,13 @@ private:
     QToolBar *m_packagesToolbar;
     QToolBar *m_filesToolbar;
     bool m_loaded;
+    bool m_projectListLoaded;
     QString m_homepage;
-    QString m_downloadPath;
+    int m_packageToken;
+    int m_downloadProgress;
+    QHash<QString, int> m_uploads;
+    // Percentage of each upload, by token
+    QHash<int, int> m_uploadProgress;
 
 private slots:
     void slotContextMenuPackages(const QPoint &point);
@@ -120,16 +127,17 @@ private slots:
     void getPackageFiles(const QString &package);
     void getBuildResults(const QString &project, const QString &package);
     void slotContextMenuFiles(const QPoint &point);
-    void addFile(QSharedPointer<OBSFile> file);
+    void addFiles(QList<QSharedPointer<OBSFile>> fileList);
     void uploadFile(const QString &path);
+    void onUploadProgress(int token, const QString &fileName, qint64 bytesSent, qint64 bytesTotal);
     void onUploadFile(QSharedPointer<OBSRevision> revision);
     void onUploadFileError(QSharedPointer<OBSStatus> status);
     void onResultsAdded();
     void onRequestCreated(QSharedPointer<OBSRequest> request);
     void slotCreateRequestStatus(QSharedPointer<OBSStatus> status);
     void onPackageBranched(QSharedPointer<OBSStatus> status);
-    void onFileFetched(const QString &fileName, const QByteArray &data);
-    void onBuildLogFetched(const QString &buildLog);
+    void onFileDownloaded(const QString &fileName, const QString &path);
+    void onDownloadProgress(const QString &fileName, qint64 bytesReceived, qint64 bytesTotal);
     void onBuildLogNotFound();
     void onProjectNotFound(QSharedPointer<OBSStatus> status);
     void onPackageNotFound(QSharedPointer<OBSStatus> status);
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018-2024 Javier Llorente <javier@opensuse.org>
+ * Copyright (C) 2018-2025 Javier Llorente <javier@opensuse.org>
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -15,18 +15,71 @@
  */
 #include "buildlogviewer.h"
 #include "ui_buildlogviewer.h"
+#include <QDebug>
+#include <QCache>
+#include <QMessageBox>
+#include <QPointer>
+#include <QThreadPool>
+#include <QStandardPaths>
+#include <QCoreApplication>
+#include "logdiff.h"
+#include "obsdiskcache.h"
+
+// Poll interval bounds while following a build (msec)
+const int minPollInterval = 2000;
+const int maxPollInterval = 30000;
+
+// Indexes of the logs opened so far, keyed by build; the cost is the number of entries
+static QCache<QString, LogIndex> indexCache(100000);
+// Max size of the build log archive (bytes)
+static const qint64 maxArchiveSize = 200 * 1024 * 1024;
+
+// Logs of finished builds, keyed by build (project/repository/arch/package)
+static OBSDiskCache &logArchive()
+{
+    static OBSDiskCache archive(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/buildlogs",
+                                maxArchiveSize);
+    return archive;
+}
+
+// The job of an archived log is stored next to it
+static QString archivedJobKey(const QString &build)
+{
+    return build + "/_jobhistory";
+}
+
+static bool isBuilding(const QString &code)
+{
+    return code == "building" || code == "dispatching" || code == "scheduled";
+}
 
 BuildLogViewer::BuildLogViewer(QWidget *parent) :
     QDialog(parent),
-    ui(new Ui::BuildLogViewer)
+    ui(new Ui::BuildLogViewer),
+    m_obs(nullptr),
+    m_offset(0),
+    m_pollTimer(new QTimer(this)),
+    m_pollInterval(minPollInterval),
+    m_dataReceived(false),
+    m_lastFetch(false),
+    m_loaded(false),
+    m_outlineEntries(0),
+    m_phaseItem(nullptr),
+    m_archivedSize(0),
+    m_archiving(false)
 {
     ui->setupUi(this);
+    ui->splitter->setSizes(QList<int>() << 200 << 500);
+    connect(ui->treeOutline, &QTreeWidget::itemClicked, this, &BuildLogViewer::onOutlineItemClicked);
+    connect(ui->pushButtonDiff, &QPushButton::clicked, this, &BuildLogViewer::compareWithLastSucceeded);
+    m_pollTimer->setSingleShot(true);
+    connect(m_pollTimer, &QTimer::timeout, this, &BuildLogViewer::pollLog);
+
     QAction *findAction = new QAction(this);
     findAction->setShortcut(QKeySequence("Ctrl+F"));
     connect(findAction, &QAction::triggered, this, &BuildLogViewer::findText);
     addAction(findAction);
 
-    ui->plainTextEdit->ensureCursorVisible();
     findText();
 }
 
@@ -37,14 +90,306 @@ BuildLogViewer::~BuildLogViewer()
 
 void BuildLogViewer::setText(const QString &text)
 {
-    ui->plainTextEdit->setPlainText(text);
+    clearLog();
+    addData(text.toUtf8());
+    m_index.flush();
+    updateOutline();
     scrollToBottom();
 }
 
+void BuildLogViewer::followLog(OBS *obs, const QString &project, const QString &repository,
+                               const QString &arch, const QString &package)
+{
+    m_obs = obs;
+    m_project = project;
+    m_repository = repository;
+    m_arch = arch;
+    m_package = package;
+    m_build = QString("%1/%2/%3/%4").arg(project, repository, arch, package);
+    setWindowTitle(tr("Build log viewer") + " - " + m_build);
+
+    LogIndex *cachedIndex = indexCache.object(m_build);
+    if (cachedIndex) {
+        m_index.resume(*cachedIndex);
+    }
+
+    connect(m_obs, &OBS::buildLogAppended, this, &BuildLogViewer::onBuildLogAppended);
+    connect(m_obs, &OBS::buildLogTailFinished, this, &BuildLogViewer::onBuildLogTailFinished);
+    connect(m_obs, &OBS::buildLogStatusFetched, this, &BuildLogViewer::onBuildLogStatusFetched);
+    connect(m_obs, &OBS::buildJobFetched, this, &BuildLogViewer::onBuildJobFetched);
+    connect(m_obs, &OBS::lastSucceededBuildLogFetched, this, &BuildLogViewer::onLastSucceededBuildLogFetched);
+    connect(m_obs, &OBS::lastSucceededBuildLogNotFound, this, &BuildLogViewer::onLastSucceededBuildLogNotFound);
+    ui->pushButtonDiff->setEnabled(true);
+
+    QByteArray archivedJob;
+    QByteArray archivedLog;
+    if (logArchive().read(archivedJobKey(m_build), archivedJob) && !archivedJob.isEmpty()
+            && logArchive().read(m_build, archivedLog) && !archivedLog.isEmpty()) {
+        qDebug() << Q_FUNC_INFO << "Archived log:" << m_build << archivedLog.size();
+        addData(archivedLog);
+        scrollToBottom();
+        m_offset = archivedLog.size();
+        m_archivedSize = archivedLog.size();
+        m_archivedJob = QString::fromUtf8(archivedJob);
+        m_obs->getBuildJob(m_project, m_repository, m_arch, m_package);
+    } else {
+        pollLog();
+    }
+}
+
+void BuildLogViewer::clearLog()
+{
+    ui->logView->clear();
+    ui->treeOutline->clear();
+    m_index.clear();
+    m_outlineEntries = 0;
+    m_phaseItem = nullptr;
+    m_offset = 0;
+}
+
+void BuildLogViewer::onBuildJobFetched(const QString &build, const QString &job)
+{
+    if (build != m_build) {
+        return;
+    }
+
+    if (m_archiving) {
+        m_archiving = false;
+        // Without its job, the log couldn't be told apart from the one of another job
+        if (!job.isEmpty()) {
+            archiveLog(job);
+            m_archivedSize = m_offset;
+        }
+        return;
+    }
+    if (m_archivedJob.isEmpty()) {
+        return;
+    }
+
+    if (job == m_archivedJob) {
+        // Same job; the status tells whether the build has started again
+        if (!m_loaded) {
+            m_loaded = true;
+            emit logLoaded();
+        }
+        m_obs->getBuildLogStatus(m_project, m_repository, m_arch, m_package);
+    } else {
+        qDebug() << Q_FUNC_INFO << "Build changed, fetching" << m_build << "log again";
+        dropArchivedLog();
+    }
+}
+
+void BuildLogViewer::dropArchivedLog()
+{
+    logArchive().remove(m_build);
+    logArchive().remove(archivedJobKey(m_build));
+    indexCache.remove(m_build);
+    m_archivedJob.clear();
+    m_archivedSize = 0;
+    clearLog();
+    pollLog();
+}
+
+void BuildLogViewer::pollLog()
+{
+    m_obs->getBuildLogTail(m_project, m_repository, m_arch, m_package, m_offset);
+}
+
+void BuildLogViewer::onBuildLogAppended(const QString &build, const QByteArray &data)
+{
+    if (build != m_build) {
+        return;
+    }
+
+    m_offset += data.size();
+    m_dataReceived = true;
+    addData(data);
+}
+
+void BuildLogViewer::addData(const QByteArray &data)
+{
+    ui->logView->appendData(data);
+    m_index.addData(data);
+    updateOutline();
+}
+
+// Adds the entries indexed since the last update
+void BuildLogViewer::updateOutline()
+{
+    const QVector<LogIndex::Entry> &entries = m_index.getEntries();
+    for (; m_outlineEntries < entries.size(); m_outlineEntries++) {
+        const LogIndex::Entry &entry = entries.at(m_outlineEntries);
+        QTreeWidgetItem *item = new QTreeWidgetItem();
+        item->setData(0, Qt::UserRole, entry.line);
+        item->setToolTip(0, entry.text);
+
+        if (entry.type == LogIndex::Phase) {
+            item->setText(0, entry.text);
+            QFont font = item->font(0);
+            font.setBold(true);
+            item->setFont(0, font);
+            ui->treeOutline->addTopLevelItem(item);
+            m_phaseItem = item;
+            continue;
+        }
+
+        item->setText(0, QString("%1: %2").arg(entry.line + 1).arg(entry.text));
+        item->setIcon(0, QIcon::fromTheme(entry.type == LogIndex::Error ? "dialog-error" : "dialog-warning"));
+        if (m_phaseItem) {
+            m_phaseItem->addChild(item);
+            if (entry.type == LogIndex::Error) {
+                m_phaseItem->setExpanded(true);
+            }
+        } else {
+            ui->treeOutline->addTopLevelItem(item);
+        }
+    }
+
+    ui->treeOutline->setHeaderLabel(tr("%1 errors, %2 warnings")
+                                    .arg(m_index.getErrorCount()).arg(m_index.getWarningCount()));
+}
+
+void BuildLogViewer::onOutlineItemClicked(QTreeWidgetItem *item)
+{
+    ui->logView->selectLine(item->data(0, Qt::UserRole).toInt());
+}
+
+void BuildLogViewer::onBuildLogTailFinished(const QString &build, bool ok)
+{
+    if (build != m_build) {
+        return;
+    }
+
+    if (!m_loaded) {
+        m_loaded = true;
+        emit logLoaded();
+    }
+
+    if (!ok) {
+        qDebug() << Q_FUNC_INFO << "Cannot fetch" << m_build << "log";
+        if (m_offset == 0) {
+            close();
+        }
+        return;
+    }
+
+    if (m_lastFetch) {
+        m_index.flush();
+        updateOutline();
+        if (m_offset != m_archivedSize) {
+            m_archiving = true;
+            m_obs->getBuildJob(m_project, m_repository, m_arch, m_package);
+        }
+    }
+    indexCache.insert(m_build, new LogIndex(m_index), m_index.getEntries().size() + 1);
+
+    if (!m_lastFetch) {
+        m_obs->getBuildLogStatus(m_project, m_repository, m_arch, m_package);
+    }
+}
+
+void BuildLogViewer::onBuildLogStatusFetched(const QString &build, const QString &code)
+{
+    if (build != m_build) {
+        return;
+    }
+
+    if (!m_archivedJob.isEmpty()) {
+        m_archivedJob.clear();
+        if (isBuilding(code)) {
+            // The log on the server is the one of the new job
+            qDebug() << Q_FUNC_INFO << "Building again, fetching" << m_build << "log again";
+            dropArchivedLog();
+            return;
+        }
+    }
+
+    if (isBuilding(code)) {
+        m_pollInterval = m_dataReceived ? minPollInterval : qMin(m_pollInterval * 2, maxPollInterval);
+        m_dataReceived = false;
+        m_pollTimer->start(m_pollInterval);
+    } else {
+        // Fetch what was written between the last poll and the end of the build
+        qDebug() << Q_FUNC_INFO << m_build << code;
+        m_lastFetch = true;
+        pollLog();
+    }
+}
+
+void BuildLogViewer::compareWithLastSucceeded()
+{
+    ui->pushButtonDiff->setEnabled(false);
+    m_obs->getLastSucceededBuildLog(m_project, m_repository, m_arch, m_package);
+}
+
+void BuildLogViewer::onLastSucceededBuildLogFetched(const QString &build, const QByteArray &data)
+{
+    if (build != m_build || ui->pushButtonDiff->isEnabled()) {
+        return;
+    }
+    ui->pushButtonDiff->setEnabled(true);
+
+    QSharedPointer<QFile> file = openLogFile();
+    qint64 size = ui->logView->size();
+    QPointer<BuildLogViewer> viewer(this);
+    QThreadPool::globalInstance()->start([viewer, file, size, data]() {
+        QByteArray log = file ? file->read(size) : QByteArray();
+        QByteArray diff = LogDiff::diff(data, log);
+        QMetaObject::invokeMethod(qApp, [viewer, diff]() {
+            if (viewer) {
+                viewer->showDiff(diff);
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+void BuildLogViewer::showDiff(const QByteArray &diff)
+{
+    BuildLogViewer *diffViewer = new BuildLogViewer(parentWidget());
+    diffViewer->setAttribute(Qt::WA_DeleteOnClose, true);
+    diffViewer->setWindowTitle(tr("Build log diff") + " - " + m_build);
+    diffViewer->setText(QString::fromUtf8(diff));
+    diffViewer->show();
+}
+
+// Opened here, so that the log can still be read once the viewer is closed
+QSharedPointer<QFile> BuildLogViewer::openLogFile()
+{
+    QSharedPointer<QFile> file(new QFile(ui->logView->getFileName()));
+    if (ui->logView->size() == 0 || !file->open(QIODevice::ReadOnly)) {
+        return QSharedPointer<QFile>();
+    }
+    return file;
+}
+
+void BuildLogViewer::archiveLog(const QString &job)
+{
+    QSharedPointer<QFile> file = openLogFile();
+    if (!file) {
+        return;
+    }
+    QString build = m_build;
+    qint64 size = ui->logView->size();
+    QThreadPool::globalInstance()->start([file, build, size, job]() {
+        // A log which is cleared meanwhile ends before size, and is not archived
+        if (logArchive().write(build, file.data(), size)) {
+            logArchive().write(archivedJobKey(build), job.toUtf8());
+        }
+    });
+}
+
+void BuildLogViewer::onLastSucceededBuildLogNotFound(const QString &build)
+{
+    if (build != m_build || ui->pushButtonDiff->isEnabled()) {
+        return;
+    }
+    ui->pushButtonDiff->setEnabled(true);
+    QMessageBox::information(this, tr("Build log diff"), tr("%1 has not succeeded yet").arg(m_build));
+}
+
 void BuildLogViewer::scrollToBottom()
 {
-    int value = ui->plainTextEdit->verticalScrollBar()->maximum();
-    ui->plainTextEdit->verticalScrollBar()->setValue(value);
+    ui->logView->scrollToBottom();
 }
 
 void BuildLogViewer::findText()
@@ -53,7 +398,7 @@ void BuildLogViewer::findText()
     SearchWidget *searchWidget = nullptr;
 
     if (ui->verticalLayout->count() == 1) {
-        searchWidget = new SearchWidget(this, ui->plainTextEdit);
+        searchWidget = new SearchWidget(this, ui->logView);
         ui->verticalLayout->insertWidget(widgetIndex, searchWidget);
     } else if (ui->verticalLayout->count() == 2) {
         searchWidget = static_cast<SearchWidget *>(ui->verticalLayout->itemAt(widgetIndex)->widget());
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Javier Llorente <javier@opensuse.org>
+ * Copyright (C) 2018-2025 Javier Llorente <javier@opensuse.org>
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -19,7 +19,13 @@
 #include <QDialog>
 #include <QScrollBar>
 #include <QAction>
+#include <QTimer>
+#include <QTreeWidgetItem>
+#include <QSharedPointer>
+#include <QFile>
 #include "searchwidget.h"
+#include "logindex.h"
+#include "obs.h"
 
 namespace Ui {
 class BuildLogViewer;
@@ -34,13 +40,74 @@ public:
     ~BuildLogViewer();
 
     void setText(const QString &text);
+    void followLog(OBS *obs, const QString &project, const QString &repository,
+                   const QString &arch, const QString &package);
 
 private:
     Ui::BuildLogViewer *ui;
     void scrollToBottom();
 
+/*
+ * Live tail: only the bytes after m_offset are fetched. The log is
+ * polled while the build is running, more often when it is growing,
+ * and fetched one last time once the build is over.
+ *
+ */
+    OBS *m_obs;
+    QString m_project;
+    QString m_repository;
+    QString m_arch;
+    QString m_package;
+    QString m_build;
+    qint64 m_offset;
+    QTimer *m_pollTimer;
+    int m_pollInterval;
+    bool m_dataReceived;
+    bool m_lastFetch;
+    bool m_loaded;
+
+/*
+ * Outline of the log; the index is cached per build, so that
+ * reopening a log doesn't classify it again.
+ *
+ */
+    LogIndex m_index;
+    int m_outlineEntries;
+    QTreeWidgetItem *m_phaseItem;
+    void clearLog();
+    void addData(const QByteArray &data);
+    void updateOutline();
+
+/*
+ * Logs of finished builds are archived along with the last job of
+ * the build (its source, build count and end time, from _jobhistory).
+ * An archived log is shown right away, and dropped if the build has
+ * had another job since, or is being built again. The archive is
+ * written from the spool file of the view and away from the GUI thread.
+ *
+ */
+    QString m_archivedJob;
+    qint64 m_archivedSize;
+    bool m_archiving;
+    QSharedPointer<QFile> openLogFile();
+    void archiveLog(const QString &job);
+    void dropArchivedLog();
+    void showDiff(const QByteArray &diff);
+
 private slots:
     void findText();
+    void pollLog();
+    void onBuildLogAppended(const QString &build, const QByteArray &data);
+    void onBuildLogTailFinished(const QString &build, bool ok);
+    void onBuildLogStatusFetched(const QString &build, const QString &code);
+    void onOutlineItemClicked(QTreeWidgetItem *item);
+    void onBuildJobFetched(const QString &build, const QString &job);
+    void compareWithLastSucceeded();
+    void onLastSucceededBuildLogFetched(const QString &build, const QByteArray &data);
+    void onLastSucceededBuildLogNotFound(const QString &build);
+
+signals:
+    void logLoaded();
 };
 
 #endif // BUILDLOGVIEWER_H
@@ -50,31 +50,34 @@ void BuildResultTreeWidget::deleteModel()
     }
 }
 
-void BuildResultTreeWidget::addResult(QSharedPointer<OBSResult> result)
+void BuildResultTreeWidget::addResults(const OBSResultSet &resultSet, const QString &project, const QString &package)
 {
     QStandardItemModel *resultModel = static_cast<QStandardItemModel*>(model());
 
     if (resultModel) {
-        if (m_project.isEmpty()) {
-            m_project = result->getProject();
-        }
-        QStandardItem *itemRepository = new QStandardItem(result->getRepository());
-        QStandardItem *itemArch = new QStandardItem(result->getArch());
-
-        if (!result->getStatusList().isEmpty()) {
-            QStandardItem *itemBuildResult = new QStandardItem(result->getStatusList().first()->getCode());
+        QList<QList<QStandardItem *>> rows;
+        for (int i = 0; i < resultSet.size(); i++) {
+            OBSResultSet::Row result = resultSet.at(i);
+            if (result.getProject() != project || result.getPackage() != package) {
+                continue;
+            }
+            if (m_project.isEmpty()) {
+                m_project = result.getProject();
+            }
+            QStandardItem *itemRepository = new QStandardItem(result.getRepository());
+            QStandardItem *itemArch = new QStandardItem(result.getArch());
+            QStandardItem *itemBuildResult = new QStandardItem(result.getCode());
             itemBuildResult->setForeground(Utils::getColorForStatus(itemBuildResult->text()));
 
-            if (!result->getStatusList().first()->getDetails().isEmpty()) {
-                QString details = result->getStatusList().first()->getDetails();
+            QString details = result.getDetails();
+            if (!details.isEmpty()) {
                 details = Utils::breakLine(details, 250);
                 itemBuildResult->setToolTip(details);
             }
 
-            QList<QStandardItem *> items;
-            items << itemRepository << itemArch << itemBuildResult;
-            resultModel->appendRow(items);
+            rows.append({itemRepository, itemArch, itemBuildResult});
         }
+        Utils::appendRows(resultModel, rows);
     }
 }
 
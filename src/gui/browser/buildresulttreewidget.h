@@ -21,6 +21,7 @@
 #include <QStandardItemModel>
 #include <QSharedPointer>
 #include "obsresult.h"
+#include "obsresultset.h"
 #include "utils.h"
 
 class BuildResultTreeWidget : public QTreeView
@@ -31,7 +32,7 @@ public:
     BuildResultTreeWidget(QWidget *parent = 0);
     void createModel();
     void deleteModel();
-    void addResult(QSharedPointer<OBSResult> result);
+    void addResults(const OBSResultSet &resultSet, const QString &project, const QString &package);
     bool hasSelection();
     QList<OBSResult> getBuilds() const;
     void clearModel();
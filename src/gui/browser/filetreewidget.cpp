@@ -16,6 +16,7 @@
 #include "filetreewidget.h"
 #include <QHeaderView>
 #include <QTimeZone>
+#include "utils.h"
 
 FileTreeWidget::FileTreeWidget(QWidget *parent) :
     QTreeView(parent),
@@ -95,37 +96,47 @@ void FileTreeWidget::onFilesAdded(const QString &project, const QString &package
     emit updateStatusBar(tr("Done"), true);
 }
 
-void FileTreeWidget::addFile(QSharedPointer<OBSFile> file)
+void FileTreeWidget::addFiles(QList<QSharedPointer<OBSFile>> fileList)
 {
     QStandardItemModel *fileModel = static_cast<QStandardItemModel*>(model());
     if (fileModel) {
         fileModel->setSortRole(Qt::UserRole);
 
-        // Name
-        QStandardItem *itemName = new QStandardItem();
-        itemName->setData(file->getName(), Qt::UserRole);
-        itemName->setData(file->getName(), Qt::DisplayRole);
-
-        // Size
-        QStandardItem *itemSize = new QStandardItem();
-        QString fileSizeHuman = locale().formattedDataSize(file->getSize().toInt());
-        itemSize->setData(QVariant(fileSizeHuman), Qt::DisplayRole);
-        itemSize->setData(file->getSize().toInt(), Qt::UserRole);
-
-        // Modified time
-        QStandardItem *itemLastModified = new QStandardItem();
-        QString lastModifiedUnixTimeStr = file->getLastModified();
-        QDateTime lastModifiedDateTime = QDateTime::fromSecsSinceEpoch(qint64(lastModifiedUnixTimeStr.toInt()), QTimeZone::UTC);
-        QString lastModifiedStr = lastModifiedDateTime.toString("dd/MM/yyyy H:mm");
-        itemLastModified->setData(lastModifiedUnixTimeStr.toInt(), Qt::UserRole);
-        itemLastModified->setData(lastModifiedStr, Qt::DisplayRole);
-
-        QList<QStandardItem *> items;
-        items << itemName << itemSize << itemLastModified;
-        fileModel->appendRow(items);
+        QList<QList<QStandardItem *>> rows;
+        rows.reserve(fileList.size());
+        foreach (QSharedPointer<OBSFile> file, fileList) {
+            rows.append(fileToItems(file));
+        }
+        Utils::appendRows(fileModel, rows);
     }
 }
 
+QList<QStandardItem *> FileTreeWidget::fileToItems(QSharedPointer<OBSFile> file)
+{
+    // Name
+    QStandardItem *itemName = new QStandardItem();
+    itemName->setData(file->getName(), Qt::UserRole);
+    itemName->setData(file->getName(), Qt::DisplayRole);
+
+    // Size
+    QStandardItem *itemSize = new QStandardItem();
+    QString fileSizeHuman = locale().formattedDataSize(file->getSize().toInt());
+    itemSize->setData(QVariant(fileSizeHuman), Qt::DisplayRole);
+    itemSize->setData(file->getSize().toInt(), Qt::UserRole);
+
+    // Modified time
+    QStandardItem *itemLastModified = new QStandardItem();
+    QString lastModifiedUnixTimeStr = file->getLastModified();
+    QDateTime lastModifiedDateTime = QDateTime::fromSecsSinceEpoch(qint64(lastModifiedUnixTimeStr.toInt()), QTimeZone::UTC);
+    QString lastModifiedStr = lastModifiedDateTime.toString("dd/MM/yyyy H:mm");
+    itemLastModified->setData(lastModifiedUnixTimeStr.toInt(), Qt::UserRole);
+    itemLastModified->setData(lastModifiedStr, Qt::DisplayRole);
+
+    QList<QStandardItem *> items;
+    items << itemName << itemSize << itemLastModified;
+    return items;
+}
+
 bool FileTreeWidget::hasLink() const
 {
     QStandardItemModel *fileModel = static_cast<QStandardItemModel *>(model());
@@ -34,7 +34,7 @@ public:
     FileTreeWidget(QWidget *parent = nullptr);
     void createModel();
     void deleteModel();
-    void addFile(QSharedPointer<OBSFile> file);
+    void addFiles(QList<QSharedPointer<OBSFile>> fileList);
     bool hasLink() const;
     QString getCurrentFile() const;
     bool removeFile(const QString &fileName);
@@ -54,6 +54,7 @@ private:
     Qt::SortOrder m_order;
     QString project;
     QString package;
+    QList<QStandardItem *> fileToItems(QSharedPointer<OBSFile> file);
 
 public slots:
     void onFilesAdded(const QString &project, const QString &package);
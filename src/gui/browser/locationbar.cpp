@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018-2024 Javier Llorente <javier@opensuse.org>
+ * Copyright (C) 2018-2025 Javier Llorente <javier@opensuse.org>
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -34,8 +34,11 @@ LocationBar::LocationBar(QWidget *parent) :
         ui->lineEditFilter->setFocus();
     });
 
+// The model only holds the matches from m_projectIndex
     m_projectCompleter->setCaseSensitivity(Qt::CaseInsensitive);
-    ui->lineEditFilter->setCompleter(m_projectCompleter);    
+    m_projectCompleter->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    ui->lineEditFilter->setCompleter(m_projectCompleter);
+    connect(ui->lineEditFilter, &QLineEdit::textEdited, this, &LocationBar::updateCompletions);
     connect(m_projectCompleter, QOverload<const QString &>::of(&QCompleter::activated),
             this, &LocationBar::autocompletedProject_clicked);
     connect(ui->lineEditFilter, &QLineEdit::returnPressed, this, [=](){
@@ -70,25 +73,20 @@ void LocationBar::setFocus()
 
 QStringList LocationBar::getProjectList() const
 {
-    return m_projectModel->stringList();
+    return m_projectIndex.getProjects();
 }
 
 bool LocationBar::addProject(const QString &project)
 {
-   if (m_projectModel->insertRow(m_projectModel->rowCount())) {
-       QModelIndex index = m_projectModel->index(m_projectModel->rowCount() - 1, 0);
-       return m_projectModel->setData(index, project);
-   }
-   return false;
+    return m_projectIndex.addProject(project);
 }
 
 bool LocationBar::removeProject(const QString &project)
 {
-    int index = m_projectModel->stringList().indexOf(project);
-    if (index == -1) {
+    if (!m_projectIndex.removeProject(project)) {
         return false;
     }
-    m_projectModel->removeRow(index);
+    m_projectModel->removeRows(0, m_projectModel->rowCount());
     return true;
 }
 
@@ -96,7 +94,26 @@ void LocationBar::addProjectList(const QStringList &projectList)
 {
     qDebug() << __PRETTY_FUNCTION__;
     ui->lineEditFilter->clear();
-    m_projectModel->setStringList(projectList);
+    m_projectModel->removeRows(0, m_projectModel->rowCount());
+    m_projectIndex.setProjects(projectList);
+}
+
+// Shows the projects received so far, unless a longer (e.g. cached)
+// list is already shown. The complete list is set with addProjectList()
+void LocationBar::addPartialProjectList(const QStringList &projectList)
+{
+    qDebug() << __PRETTY_FUNCTION__ << projectList.size();
+    if (projectList.size() > m_projectIndex.size()) {
+        m_projectIndex.setProjects(projectList);
+        if (!ui->lineEditFilter->text().isEmpty()) {
+            updateCompletions(ui->lineEditFilter->text());
+        }
+    }
+}
+
+void LocationBar::updateCompletions(const QString &text)
+{
+    m_projectModel->setStringList(m_projectIndex.find(text, maxCompletions));
 }
 
 void LocationBar::autocompletedProject_clicked(const QString &project)
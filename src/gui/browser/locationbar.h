@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018-2024 Javier Llorente <javier@opensuse.org>
+ * Copyright (C) 2018-2025 Javier Llorente <javier@opensuse.org>
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -19,6 +19,7 @@
 #include <QWidget>
 #include <QStringListModel>
 #include <QCompleter>
+#include "projectindex.h"
 
 namespace Ui {
 class LocationBar;
@@ -42,14 +43,18 @@ public:
 
 public slots:
     void addProjectList(const QStringList &projectList);
+    void addPartialProjectList(const QStringList &projectList);
 
 private:
     Ui::LocationBar *ui;
     QStringListModel *m_projectModel;
     QCompleter *m_projectCompleter;
+    ProjectIndex m_projectIndex;
+    static const int maxCompletions = 50;
 
 private slots:
     void autocompletedProject_clicked(const QString &project);
+    void updateCompletions(const QString &text);
 
 signals:
     void projectChanged(const QString &project);
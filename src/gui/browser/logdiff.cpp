@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "logdiff.h"
+#include <algorithm>
+
+// Past this, the changed lines are not compared any further
+static const int maxEdits = 2000;
+static const int contextLines = 3;
+
+QList<QByteArray> LogDiff::splitLines(const QByteArray &log)
+{
+    QList<QByteArray> lines = log.split('\n');
+    if (!lines.isEmpty() && lines.last().isEmpty()) {
+        lines.removeLast();
+    }
+
+    for (QByteArray &line : lines) {
+        if (line.endsWith('\r')) {
+            line.chop(1);
+        }
+        // Strip the "[  123s] " prefix
+        if (line.startsWith('[')) {
+            int pos = line.indexOf("s] ");
+            if (pos > 0 && pos < 16) {
+                line = line.mid(pos + 3);
+            }
+        }
+    }
+    return lines;
+}
+
+QByteArray LogDiff::diff(const QByteArray &oldLog, const QByteArray &newLog)
+{
+    const QList<QByteArray> oldLines = splitLines(oldLog);
+    const QList<QByteArray> newLines = splitLines(newLog);
+
+    // Common head and tail
+    int begin = 0;
+    while (begin < oldLines.size() && begin < newLines.size() && oldLines.at(begin) == newLines.at(begin)) {
+        begin++;
+    }
+    int oldEnd = oldLines.size();
+    int newEnd = newLines.size();
+    while (oldEnd > begin && newEnd > begin && oldLines.at(oldEnd - 1) == newLines.at(newEnd - 1)) {
+        oldEnd--;
+        newEnd--;
+    }
+
+    QVector<Edit> edits;
+    for (int i = 0; i < begin; i++) {
+        edits.append({Equal, i, i});
+    }
+    if (!shortestEdit(oldLines, newLines, begin, oldEnd, newEnd, edits)) {
+        for (int i = begin; i < oldEnd; i++) {
+            edits.append({Delete, i, begin});
+        }
+        for (int i = begin; i < newEnd; i++) {
+            edits.append({Insert, oldEnd, i});
+        }
+    }
+    for (int i = 0; i < oldLines.size() - oldEnd; i++) {
+        edits.append({Equal, oldEnd + i, newEnd + i});
+    }
+
+    // Hunks with contextLines of context around the changes
+    QByteArray result;
+    int i = 0;
+    while (i < edits.size()) {
+        while (i < edits.size() && edits.at(i).operation == Equal) {
+            i++;
+        }
+        if (i == edits.size()) {
+            break;
+        }
+
+        int first = qMax(0, i - contextLines);
+        int last = i;
+        int equalLines = 0;
+        for (int j = i; j < edits.size(); j++) {
+            if (edits.at(j).operation == Equal) {
+                if (++equalLines > 2 * contextLines) {
+                    break;
+                }
+            } else {
+                equalLines = 0;
+                last = j;
+            }
+        }
+        last = qMin<int>(edits.size() - 1, last + contextLines);
+
+        int oldCount = 0;
+        int newCount = 0;
+        QByteArray hunk;
+        for (int j = first; j <= last; j++) {
+            const Edit &edit = edits.at(j);
+            switch (edit.operation) {
+            case Equal:
+                hunk += " " + oldLines.at(edit.oldLine) + "\n";
+                oldCount++;
+                newCount++;
+                break;
+            case Delete:
+                hunk += "-" + oldLines.at(edit.oldLine) + "\n";
+                oldCount++;
+                break;
+            case Insert:
+                hunk += "+" + newLines.at(edit.newLine) + "\n";
+                newCount++;
+                break;
+            }
+        }
+        result += QString("@@ -%1,%2 +%3,%4 @@\n").arg(edits.at(first).oldLine + 1).arg(oldCount)
+                .arg(edits.at(first).newLine + 1).arg(newCount).toLatin1();
+        result += hunk;
+        i = last + 1;
+    }
+    return result;
+}
+
+// Myers' algorithm on [begin, oldEnd) and [begin, newEnd); false if there are too many edits
+bool LogDiff::shortestEdit(const QList<QByteArray> &oldLines, const QList<QByteArray> &newLines,
+                           int begin, int oldEnd, int newEnd, QVector<Edit> &edits)
+{
+    const int n = oldEnd - begin;
+    const int m = newEnd - begin;
+    const int max = qMin(n + m, maxEdits);
+    auto equal = [&](int x, int y) {
+        return oldLines.at(begin + x) == newLines.at(begin + y);
+    };
+
+    // v[k] is the furthest x on diagonal k; trace[d] keeps v (for -d..d) before step d
+    QVector<int> v(2 * max + 3, 0);
+    const int offset = max + 1;
+    QVector<QVector<int>> trace;
+    int steps = -1;
+    for (int d = 0; d <= max && steps < 0; d++) {
+        trace.append(v.mid(offset - d, 2 * d + 1));
+        for (int k = -d; k <= d; k += 2) {
+            int x = (k == -d || (k != d && v[offset + k - 1] < v[offset + k + 1]))
+                    ? v[offset + k + 1] : v[offset + k - 1] + 1;
+            int y = x - k;
+            while (x < n && y < m && equal(x, y)) {
+                x++;
+                y++;
+            }
+            v[offset + k] = x;
+            if (x >= n && y >= m) {
+                steps = d;
+                break;
+            }
+        }
+    }
+    if (steps < 0) {
+        return false;
+    }
+
+    // Walk back from (n, m)
+    QVector<Edit> script;
+    int x = n;
+    int y = m;
+    for (int d = steps; d > 0; d--) {
+        const QVector<int> &previous = trace.at(d);
+        auto at = [&](int k) {
+            return previous.at(k + d);
+        };
+        int k = x - y;
+        int previousK = (k == -d || (k != d && at(k - 1) < at(k + 1))) ? k + 1 : k - 1;
+        int previousX = at(previousK);
+        int previousY = previousX - previousK;
+        while (x > previousX && y > previousY) {
+            x--;
+            y--;
+            script.append({Equal, begin + x, begin + y});
+        }
+        if (x == previousX) {
+            y--;
+            script.append({Insert, begin + x, begin + y});
+        } else {
+            x--;
+            script.append({Delete, begin + x, begin + y});
+        }
+    }
+    while (x > 0 && y > 0) {
+        x--;
+        y--;
+        script.append({Equal, begin + x, begin + y});
+    }
+
+    std::reverse(script.begin(), script.end());
+    edits += script;
+    return true;
+}
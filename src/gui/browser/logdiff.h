@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOGDIFF_H
+#define LOGDIFF_H
+
+#include <QByteArray>
+#include <QList>
+#include <QVector>
+
+/*
+ * Line diff of two build logs, in unified format.
+ *
+ * The "[  123s] " prefixes of OBS are removed first, so that only
+ * lines which actually changed are reported. After trimming the
+ * common head and tail, the lines in between are compared with
+ * Myers' algorithm; logs which differ in more than maxEdits lines
+ * are reported as a single change.
+ *
+ */
+class LogDiff
+{
+public:
+    static QByteArray diff(const QByteArray &oldLog, const QByteArray &newLog);
+
+private:
+    enum Operation {
+        Equal,
+        Delete,
+        Insert
+    };
+    struct Edit {
+        Operation operation;
+        int oldLine;
+        int newLine;
+    };
+    static QList<QByteArray> splitLines(const QByteArray &log);
+    static bool shortestEdit(const QList<QByteArray> &oldLines, const QList<QByteArray> &newLines,
+                             int begin, int oldEnd, int newEnd, QVector<Edit> &edits);
+};
+
+#endif // LOGDIFF_H
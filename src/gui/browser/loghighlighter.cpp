@@ -1,33 +0,0 @@
-/*
- * Copyright (C) 2018 Javier Llorente <javier@opensuse.org>
- *
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-#include "loghighlighter.h"
-
-LogHighlighter::LogHighlighter(QTextDocument *parent, const QString &searchText)
-    : QSyntaxHighlighter(parent)
-{
-    QColor yellow(255, 255, 0);
-    format.setBackground(yellow);
-    pattern = QRegularExpression(searchText, QRegularExpression::CaseInsensitiveOption);
-}
-
-void LogHighlighter::highlightBlock(const QString &text)
-{
-    QRegularExpressionMatchIterator matchIterator = pattern.globalMatch(text);
-    while (matchIterator.hasNext()) {
-        QRegularExpressionMatch match = matchIterator.next();
-        setFormat(match.capturedStart(), match.capturedLength(), format);
-    }
-}
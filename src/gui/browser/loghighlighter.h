@@ -1,38 +0,0 @@
-/*
- * Copyright (C) 2018 Javier Llorente <javier@opensuse.org>
- *
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-#ifndef LOGHIGHLIGHTER_H
-#define LOGHIGHLIGHTER_H
-
-#include <QObject>
-#include <QSyntaxHighlighter>
-#include <QTextDocument>
-#include <QRegularExpression>
-#include <QRegularExpressionMatchIterator>
-
-class LogHighlighter : public QSyntaxHighlighter
-{
-public:
-    LogHighlighter(QTextDocument *parent = nullptr, const QString &searchText = "");
-
-protected:
-    void highlightBlock(const QString &text);
-
-private:
-    QRegularExpression pattern;
-    QTextCharFormat format;
-};
-
-#endif // LOGHIGHLIGHTER_H
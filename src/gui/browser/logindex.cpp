@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "logindex.h"
+#include <cstring>
+
+// Bytes compared to tell whether a cached index is for the same log
+static const int headSize = 1024;
+// Only the start of (very) long lines is classified
+static const int maxLineLength = 4096;
+// Entries kept for the outline; errors and warnings are still counted
+static const int maxEntries = 10000;
+
+LogIndex::LogIndex() :
+    m_errorCount(0),
+    m_warningCount(0),
+    m_size(0),
+    m_line(0),
+    m_received(0)
+{
+
+}
+
+void LogIndex::clear()
+{
+    *this = LogIndex();
+}
+
+// Continue from index (e.g. a cached one), once the head of the log matches
+void LogIndex::resume(const LogIndex &index)
+{
+    if (!index.m_resumed.isEmpty()) {
+        // Not resumed yet itself
+        resume(index.m_resumed.first());
+        return;
+    }
+    clear();
+    m_resumed.append(index);
+}
+
+void LogIndex::addData(const QByteArray &data)
+{
+    if (!m_resumed.isEmpty()) {
+        // Hold back the data until the head can be compared
+        m_head.append(data);
+        if (m_head.size() < m_resumed.first().m_head.size()) {
+            return;
+        }
+
+        QByteArray received = m_head;
+        LogIndex resumed = m_resumed.takeFirst();
+        if (received.startsWith(resumed.m_head)) {
+            *this = resumed;
+            m_received = 0;
+        } else {
+            clear();
+        }
+        addData(received);
+        return;
+    }
+
+    // Data which a resumed index already covers is skipped
+    const qint64 offset = m_received;
+    m_received += data.size();
+    if (m_received > m_size) {
+        const qint64 skip = m_size - offset;
+        process(data.constData() + skip, data.size() - skip);
+    }
+}
+
+// Index the last line of a log which doesn't end with a newline
+void LogIndex::flush()
+{
+    if (!m_resumed.isEmpty()) {
+        // The log is shorter than the head of the cached one
+        QByteArray received = m_head;
+        clear();
+        addData(received);
+    }
+
+    if (!m_partialLine.isEmpty()) {
+        addLine(m_partialLine);
+        m_partialLine.clear();
+        m_line++;
+    }
+}
+
+qint64 LogIndex::size() const
+{
+    return m_size;
+}
+
+const QVector<LogIndex::Entry> &LogIndex::getEntries() const
+{
+    return m_entries;
+}
+
+int LogIndex::getErrorCount() const
+{
+    return m_errorCount;
+}
+
+int LogIndex::getWarningCount() const
+{
+    return m_warningCount;
+}
+
+void LogIndex::process(const char *data, qint64 length)
+{
+    if (m_size < headSize) {
+        m_head.append(data, int(qMin<qint64>(length, headSize - m_size)));
+    }
+    m_size += length;
+
+    const char *end = data + length;
+    const char *p = data;
+    const char *newline;
+    while ((newline = static_cast<const char *>(memchr(p, '\n', end - p)))) {
+        if (m_partialLine.isEmpty()) {
+            addLine(QByteArray::fromRawData(p, int(qMin<qint64>(newline - p, maxLineLength))));
+        } else {
+            m_partialLine.append(p, int(qMin<qint64>(newline - p, maxLineLength - m_partialLine.size())));
+            addLine(m_partialLine);
+            m_partialLine.clear();
+        }
+        m_line++;
+        p = newline + 1;
+    }
+    if (p < end) {
+        m_partialLine.append(p, int(qMin<qint64>(end - p, maxLineLength - m_partialLine.size())));
+    }
+}
+
+void LogIndex::addLine(QByteArray line)
+{
+    if (line.endsWith('\r')) {
+        line.chop(1);
+    }
+
+    // Strip the "[  123s] " prefix
+    if (line.startsWith('[')) {
+        int pos = line.indexOf("s] ");
+        if (pos > 0 && pos < 16) {
+            line = line.mid(pos + 3);
+        }
+    }
+
+    if (line.startsWith("Executing(%")) {
+        int pos = line.indexOf(')');
+        if (pos > 0) {
+            addEntry(Phase, line.mid(10, pos - 10));
+        }
+    } else if (line.startsWith("RPMLINT report:")) {
+        addEntry(Phase, "rpmlint");
+    } else if (line.contains(": error: ") || line.contains(": fatal error: ") || line.startsWith("error: ")
+               || line.startsWith("ERROR: ") || line.startsWith("FAILED: ") || line.contains(": E: ")
+               || line.contains("undefined reference to")
+               || (line.startsWith("make") && line.contains(": *** "))) {
+        m_errorCount++;
+        addEntry(Error, line);
+    } else if (line.contains(": warning: ") || line.startsWith("warning: ") || line.contains(": W: ")) {
+        m_warningCount++;
+        addEntry(Warning, line);
+    }
+}
+
+void LogIndex::addEntry(EntryType type, const QByteArray &text)
+{
+    // Phases are always kept, so that the outline still has all of them
+    if (m_entries.size() >= maxEntries && type != Phase) {
+        return;
+    }
+
+    Entry entry;
+    entry.type = type;
+    entry.line = m_line;
+    entry.text = QString::fromUtf8(text.trimmed());
+    m_entries.append(entry);
+}
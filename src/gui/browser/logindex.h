@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOGINDEX_H
+#define LOGINDEX_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+/*
+ * Outline of a build log: build phases, errors and warnings.
+ *
+ * The log is indexed in a single pass as it is received. Lines are
+ * classified on their raw bytes, with the "[  123s] " prefix of OBS
+ * removed, by gcc/clang, make, rpmbuild and rpmlint patterns.
+ *
+ * An index can be resumed from an earlier (cached) one for the same
+ * build. The data before the cached size is skipped, as long as the
+ * log still starts with the same bytes.
+ *
+ */
+class LogIndex
+{
+public:
+    enum EntryType {
+        Phase,
+        Error,
+        Warning
+    };
+    struct Entry {
+        EntryType type;
+        int line;
+        QString text;
+    };
+    LogIndex();
+    void clear();
+    void resume(const LogIndex &index);
+    void addData(const QByteArray &data);
+    void flush();
+    qint64 size() const;
+    const QVector<Entry> &getEntries() const;
+    int getErrorCount() const;
+    int getWarningCount() const;
+
+private:
+    QVector<Entry> m_entries;
+    int m_errorCount;
+    int m_warningCount;
+    qint64 m_size;
+    int m_line;
+    QByteArray m_partialLine;
+    QByteArray m_head;
+    qint64 m_received;
+    QVector<LogIndex> m_resumed;
+    void process(const char *data, qint64 length);
+    void addLine(QByteArray line);
+    void addEntry(EntryType type, const QByteArray &text);
+};
+
+#endif // LOGINDEX_H
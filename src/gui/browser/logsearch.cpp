@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "logsearch.h"
+#include <QString>
+#include <QtAlgorithms>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+static inline char asciiLower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? char(c + ('a' - 'A')) : c;
+}
+
+static inline char asciiUpper(char c)
+{
+    return (c >= 'a' && c <= 'z') ? char(c - ('a' - 'A')) : c;
+}
+
+static inline bool matchesAt(const char *data, const QByteArray &needle)
+{
+    for (int i = 0; i < needle.size(); i++) {
+        if (asciiLower(data[i]) != needle.at(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QByteArray LogSearch::toNeedle(const QString &text)
+{
+    QByteArray needle = text.toUtf8();
+    for (char &c : needle) {
+        c = asciiLower(c);
+    }
+    return needle;
+}
+
+// First match starting at or after from which ends before to, or -1
+qint64 LogSearch::indexOf(const char *data, qint64 from, qint64 to, const QByteArray &needle)
+{
+    const qint64 length = needle.size();
+    const qint64 last = to - length;
+    qint64 i = qMax<qint64>(0, from);
+    if (length == 0) {
+        return -1;
+    }
+
+#ifdef __SSE2__
+    const char firstChar = needle.at(0);
+    const char lastChar = needle.at(length - 1);
+    const __m128i firstLower = _mm_set1_epi8(firstChar);
+    const __m128i firstUpper = _mm_set1_epi8(asciiUpper(firstChar));
+    const __m128i lastLower = _mm_set1_epi8(lastChar);
+    const __m128i lastUpper = _mm_set1_epi8(asciiUpper(lastChar));
+
+    // Both loads stay within [i, to) as long as i + 15 <= last
+    for (; i + 15 <= last; i += 16) {
+        const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + length - 1));
+        const __m128i eqFirst = _mm_or_si128(_mm_cmpeq_epi8(blockFirst, firstLower),
+                                             _mm_cmpeq_epi8(blockFirst, firstUpper));
+        const __m128i eqLast = _mm_or_si128(_mm_cmpeq_epi8(blockLast, lastLower),
+                                            _mm_cmpeq_epi8(blockLast, lastUpper));
+        uint mask = uint(_mm_movemask_epi8(_mm_and_si128(eqFirst, eqLast)));
+        while (mask) {
+            const int bit = qCountTrailingZeroBits(mask);
+            if (matchesAt(data + i + bit, needle)) {
+                return i + bit;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    const char first = needle.at(0);
+    for (; i <= last; i++) {
+        if (asciiLower(data[i]) == first && matchesAt(data + i, needle)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Last match starting at or before from, or -1
+qint64 LogSearch::lastIndexOf(const char *data, qint64 from, const QByteArray &needle)
+{
+    if (needle.isEmpty()) {
+        return -1;
+    }
+
+    const char first = needle.at(0);
+    for (qint64 i = from; i >= 0; i--) {
+        if (asciiLower(data[i]) == first && matchesAt(data + i, needle)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Non-overlapping matches in [from, to), up to maxMatches in total
+void LogSearch::findAll(const char *data, qint64 from, qint64 to, const QByteArray &needle,
+                        QVector<qint64> &matches, int maxMatches)
+{
+    qint64 offset = from;
+    while (matches.size() < maxMatches) {
+        offset = indexOf(data, offset, to, needle);
+        if (offset < 0) {
+            break;
+        }
+        matches.append(offset);
+        offset += needle.size();
+    }
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOGSEARCH_H
+#define LOGSEARCH_H
+
+#include <QByteArray>
+#include <QVector>
+
+/*
+ * Case-insensitive (ASCII) substring search over raw log bytes.
+ *
+ * Needles are UTF-8 and must be passed through toNeedle() first.
+ * With SSE2, candidates are found 16 bytes at a time by comparing
+ * both the first and the last byte of the needle, and only those are
+ * checked byte by byte. Other targets use the scalar loop.
+ *
+ */
+class LogSearch
+{
+public:
+    static QByteArray toNeedle(const QString &text);
+    static qint64 indexOf(const char *data, qint64 from, qint64 to, const QByteArray &needle);
+    static qint64 lastIndexOf(const char *data, qint64 from, const QByteArray &needle);
+    static void findAll(const char *data, qint64 from, qint64 to, const QByteArray &needle,
+                        QVector<qint64> &matches, int maxMatches);
+};
+
+#endif // LOGSEARCH_H
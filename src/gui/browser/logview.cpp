@@ -0,0 +1,599 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "logview.h"
+#include "logsearch.h"
+#include <QPainter>
+#include <QScrollBar>
+#include <QFontDatabase>
+#include <QGuiApplication>
+#include <QClipboard>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+// Left/right padding of the text (px)
+static const int margin = 4;
+// Lines longer than this (in bytes) are not scrollable to the end
+static const qint64 maxColumns = 1000000;
+static const int tabWidth = 8;
+// Matches kept for counting/minimap; past this, find next/previous scans the log
+static const int maxMatches = 1000000;
+static const int minimapWidth = 12;
+
+LogView::LogView(QWidget *parent) :
+    QAbstractScrollArea(parent),
+    m_map(nullptr),
+    m_mappedSize(0),
+    m_size(0),
+    m_longestLine(0),
+    m_matchesTruncated(false),
+    m_matchOffset(-1),
+    m_highlightMatches(false),
+    m_minimap(new QWidget(this)),
+    m_selectionAnchor(-1),
+    m_selectionEnd(-1)
+{
+    m_lineStarts.append(0);
+    setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    setFocusPolicy(Qt::StrongFocus);
+    viewport()->setBackgroundRole(QPalette::Base);
+    viewport()->setAutoFillBackground(true);
+    viewport()->setCursor(Qt::IBeamCursor);
+    m_minimap->installEventFilter(this);
+    m_minimap->setCursor(Qt::PointingHandCursor);
+    m_minimap->hide();
+    updateScrollBars();
+}
+
+LogView::~LogView()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+    }
+}
+
+void LogView::clear()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    m_mappedSize = 0;
+    if (m_file.isOpen()) {
+        m_file.resize(0);
+        m_file.seek(0);
+    }
+
+    m_size = 0;
+    m_lineStarts.clear();
+    m_lineStarts.append(0);
+    m_longestLine = 0;
+    m_matches.clear();
+    m_matchesTruncated = false;
+    m_matchOffset = -1;
+    m_selectionAnchor = -1;
+    m_selectionEnd = -1;
+    updateScrollBars();
+    viewport()->update();
+    emit matchesChanged();
+}
+
+bool LogView::appendData(const QByteArray &data)
+{
+    if (data.isEmpty()) {
+        return true;
+    }
+
+    if (!m_file.isOpen() && !m_file.open()) {
+        qDebug() << Q_FUNC_INFO << "Cannot open" << m_file.fileName() << m_file.errorString();
+        return false;
+    }
+    if (m_file.write(data) != data.size() || !m_file.flush()) {
+        qDebug() << Q_FUNC_INFO << "Cannot write" << m_file.fileName() << m_file.errorString();
+        return false;
+    }
+
+    QScrollBar *scrollBar = verticalScrollBar();
+    bool atBottom = scrollBar->value() == scrollBar->maximum();
+
+    const char *begin = data.constData();
+    const char *end = begin + data.size();
+    const char *p = begin;
+    while ((p = static_cast<const char *>(memchr(p, '\n', end - p)))) {
+        qint64 start = m_size + (p - begin) + 1;
+        m_longestLine = qMax(m_longestLine, start - 1 - m_lineStarts.last());
+        m_lineStarts.append(start);
+        p++;
+    }
+    qint64 oldSize = m_size;
+    m_size += data.size();
+    m_longestLine = qMax(m_longestLine, m_size - m_lineStarts.last());
+
+    // Only the new bytes (and a match which may straddle them) are searched
+    if (!m_needle.isEmpty() && !m_matchesTruncated) {
+        qint64 from = qMax<qint64>(0, oldSize - m_needle.size() + 1);
+        if (!m_matches.isEmpty()) {
+            from = qMax(from, m_matches.last() + m_needle.size());
+        }
+        int count = m_matches.size();
+        LogSearch::findAll(mappedData(), from, m_size, m_needle, m_matches, maxMatches);
+        m_matchesTruncated = m_matches.size() >= maxMatches;
+        if (m_matches.size() != count) {
+            emit matchesChanged();
+        }
+    }
+
+    updateScrollBars();
+    if (atBottom) {
+        scrollToBottom();
+    }
+    viewport()->update();
+    return true;
+}
+
+qint64 LogView::size() const
+{
+    return m_size;
+}
+
+// Name of the spool file; empty until data is appended
+QString LogView::getFileName() const
+{
+    return m_file.fileName();
+}
+
+int LogView::lineCount() const
+{
+    return int(m_lineStarts.size());
+}
+
+QString LogView::getLine(int line)
+{
+    const char *data = mappedData();
+    if (!data || line < 0 || line >= lineCount()) {
+        return QString();
+    }
+
+    qint64 start = m_lineStarts.at(line);
+    QString text = QString::fromUtf8(data + start, lineEnd(line) - start);
+    if (text.endsWith('\r')) {
+        text.chop(1);
+    }
+    return text;
+}
+
+int LogView::setSearchText(const QString &text)
+{
+    QByteArray needle = LogSearch::toNeedle(text);
+    if (needle == m_needle) {
+        return m_matches.size();
+    }
+
+    m_needle = needle;
+    m_matches.clear();
+    m_matchOffset = -1;
+    const char *data = mappedData();
+    if (data && !m_needle.isEmpty()) {
+        LogSearch::findAll(data, 0, m_size, m_needle, m_matches, maxMatches);
+    }
+    m_matchesTruncated = m_matches.size() >= maxMatches;
+
+    updateMinimap();
+    viewport()->update();
+    emit matchesChanged();
+    return m_matches.size();
+}
+
+bool LogView::find(const QString &text, bool backward)
+{
+    setSearchText(text);
+    const char *data = mappedData();
+    if (!data || m_needle.isEmpty()) {
+        return false;
+    }
+
+// Search from the current match, or from the visible lines
+    qint64 from;
+    int firstLine = verticalScrollBar()->value();
+    if (m_matchOffset >= 0) {
+        from = backward ? m_matchOffset - 1 : m_matchOffset + 1;
+    } else if (backward) {
+        from = lineEnd(qMin(lineCount() - 1, firstLine + visibleLines()));
+    } else {
+        from = m_lineStarts.at(firstLine);
+    }
+
+    qint64 offset = -1;
+    if (backward) {
+        from = qMin(from, m_size - m_needle.size());
+        auto it = std::upper_bound(m_matches.cbegin(), m_matches.cend(), from);
+        if (m_matchesTruncated && (m_matches.isEmpty() || from > m_matches.last())) {
+            offset = LogSearch::lastIndexOf(data, from, m_needle);
+        } else if (it != m_matches.cbegin()) {
+            offset = *(it - 1);
+        }
+    } else {
+        auto it = std::lower_bound(m_matches.cbegin(), m_matches.cend(), from);
+        if (it != m_matches.cend()) {
+            offset = *it;
+        } else if (m_matchesTruncated) {
+            offset = LogSearch::indexOf(data, from, m_size, m_needle);
+        }
+    }
+    if (offset < 0) {
+        return false;
+    }
+    m_matchOffset = offset;
+
+    int line = lineAt(offset);
+    if (line < firstLine || line >= firstLine + visibleLines()) {
+        scrollToLine(line);
+    }
+    qint64 lineStart = m_lineStarts.at(line);
+    int column = expandTabs(QString::fromUtf8(data + lineStart, offset - lineStart)).size();
+    int x = column * charWidth();
+    QScrollBar *scrollBar = horizontalScrollBar();
+    if (x < scrollBar->value() || x + m_needle.size() * charWidth() > scrollBar->value() + viewport()->width()) {
+        scrollBar->setValue(x - viewport()->width() / 2);
+    }
+
+    viewport()->update();
+    m_minimap->update();
+    emit matchesChanged();
+    return true;
+}
+
+int LogView::getMatchCount() const
+{
+    return m_matches.size();
+}
+
+bool LogView::isMatchCountExact() const
+{
+    return !m_matchesTruncated;
+}
+
+// Index of the current match, or -1
+int LogView::getCurrentMatch() const
+{
+    auto it = std::lower_bound(m_matches.cbegin(), m_matches.cend(), m_matchOffset);
+    if (m_matchOffset < 0 || it == m_matches.cend() || *it != m_matchOffset) {
+        return -1;
+    }
+    return int(it - m_matches.cbegin());
+}
+
+void LogView::clearMatch()
+{
+    m_matchOffset = -1;
+    viewport()->update();
+    m_minimap->update();
+    emit matchesChanged();
+}
+
+void LogView::setHighlightMatches(bool highlight)
+{
+    m_highlightMatches = highlight;
+    viewport()->update();
+}
+
+void LogView::scrollToLine(int line)
+{
+    verticalScrollBar()->setValue(line - visibleLines() / 2);
+}
+
+void LogView::selectLine(int line)
+{
+    if (line < 0 || line >= lineCount()) {
+        return;
+    }
+
+    m_selectionAnchor = line;
+    m_selectionEnd = line;
+    int firstLine = verticalScrollBar()->value();
+    if (line < firstLine || line >= firstLine + visibleLines()) {
+        scrollToLine(line);
+    }
+    viewport()->update();
+}
+
+void LogView::scrollToBottom()
+{
+    verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+}
+
+void LogView::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+    const char *data = mappedData();
+    if (!data) {
+        return;
+    }
+
+    QPainter painter(viewport());
+    const int height = lineHeight();
+    const int width = charWidth();
+    const int ascent = fontMetrics().ascent();
+    const int scrollX = horizontalScrollBar()->value();
+    const int firstColumn = scrollX / width;
+    const int columns = viewport()->width() / width + 2;
+    const int firstLine = verticalScrollBar()->value();
+    const int lastLine = qMin(lineCount() - 1, firstLine + visibleLines());
+    const int selectionFirst = qMin(m_selectionAnchor, m_selectionEnd);
+    const int selectionLast = qMax(m_selectionAnchor, m_selectionEnd);
+    const QColor highlightColor(255, 255, 0);
+
+    // Matches in the visible lines only
+    QVector<qint64> matches;
+    if (m_highlightMatches && !m_needle.isEmpty()) {
+        LogSearch::findAll(data, m_lineStarts.at(firstLine), lineEnd(lastLine), m_needle, matches, maxMatches);
+    }
+    int match = 0;
+    const int matchColumns = QString::fromUtf8(m_needle).size();
+
+    for (int line = firstLine; line <= lastLine; line++) {
+        const int y = (line - firstLine) * height;
+        const qint64 start = m_lineStarts.at(line);
+        const qint64 end = lineEnd(line);
+
+        // Only the visible part of long lines is decoded (up to 4 bytes per column)
+        qint64 length = qMin(end - start, qint64(firstColumn + columns) * 4);
+        QString text = expandTabs(QString::fromUtf8(data + start, length));
+        if (text.endsWith('\r')) {
+            text.chop(1);
+        }
+
+        bool selected = selectionFirst >= 0 && line >= selectionFirst && line <= selectionLast;
+        if (selected) {
+            painter.fillRect(0, y, viewport()->width(), height, palette().highlight());
+        }
+
+        for (; match < matches.size() && matches.at(match) < end; match++) {
+            int column = expandTabs(QString::fromUtf8(data + start, matches.at(match) - start)).size();
+            painter.fillRect(margin - scrollX + column * width, y, matchColumns * width, height, highlightColor);
+        }
+
+        if (m_matchOffset >= start && m_matchOffset <= end) {
+            int column = expandTabs(QString::fromUtf8(data + start, m_matchOffset - start)).size();
+            painter.fillRect(margin - scrollX + column * width, y, matchColumns * width, height,
+                             palette().highlight());
+        }
+
+        painter.setPen(selected ? palette().highlightedText().color() : palette().text().color());
+        painter.drawText(margin - scrollX + firstColumn * width, y + ascent, text.mid(firstColumn, columns));
+    }
+}
+
+void LogView::resizeEvent(QResizeEvent *event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars();
+    updateMinimap();
+}
+
+void LogView::scrollContentsBy(int dx, int dy)
+{
+    Q_UNUSED(dx)
+    Q_UNUSED(dy)
+    viewport()->update();
+    m_minimap->update();
+}
+
+bool LogView::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == m_minimap) {
+        if (event->type() == QEvent::Paint) {
+            paintMinimap();
+            return true;
+        }
+        if (event->type() == QEvent::MouseButtonPress || event->type() == QEvent::MouseMove) {
+            // Jump to the clicked position of the log
+            QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+            if (mouseEvent->buttons() & Qt::LeftButton) {
+                int y = qBound(0, mouseEvent->position().toPoint().y(), m_minimap->height());
+                scrollToLine(int(qint64(y) * lineCount() / qMax(1, m_minimap->height())));
+            }
+            return true;
+        }
+    }
+    return QAbstractScrollArea::eventFilter(watched, event);
+}
+
+void LogView::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton) {
+        QAbstractScrollArea::mousePressEvent(event);
+        return;
+    }
+
+    int line = lineAtY(event->position().toPoint().y());
+    if (!(event->modifiers() & Qt::ShiftModifier) || m_selectionAnchor < 0) {
+        m_selectionAnchor = line;
+    }
+    m_selectionEnd = line;
+    viewport()->update();
+}
+
+void LogView::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!(event->buttons() & Qt::LeftButton) || m_selectionAnchor < 0) {
+        QAbstractScrollArea::mouseMoveEvent(event);
+        return;
+    }
+
+    int y = event->position().toPoint().y();
+    if (y < 0) {
+        verticalScrollBar()->triggerAction(QAbstractSlider::SliderSingleStepSub);
+    } else if (y > viewport()->height()) {
+        verticalScrollBar()->triggerAction(QAbstractSlider::SliderSingleStepAdd);
+    }
+    m_selectionEnd = lineAtY(y);
+    viewport()->update();
+}
+
+void LogView::keyPressEvent(QKeyEvent *event)
+{
+    if (event->matches(QKeySequence::Copy)) {
+        copySelection();
+    } else if (event->matches(QKeySequence::SelectAll)) {
+        m_selectionAnchor = 0;
+        m_selectionEnd = lineCount() - 1;
+        viewport()->update();
+    } else if (event->matches(QKeySequence::MoveToStartOfDocument)) {
+        verticalScrollBar()->setValue(0);
+    } else if (event->matches(QKeySequence::MoveToEndOfDocument)) {
+        scrollToBottom();
+    } else {
+        QAbstractScrollArea::keyPressEvent(event);
+    }
+}
+
+const char *LogView::mappedData()
+{
+    // The file grows while the log is followed, map it again when needed
+    if (m_mappedSize < m_size) {
+        if (m_map) {
+            m_file.unmap(m_map);
+        }
+        m_map = m_file.map(0, m_size);
+        m_mappedSize = m_map ? m_size : 0;
+        if (!m_map) {
+            qDebug() << Q_FUNC_INFO << "Cannot map" << m_file.fileName() << m_file.errorString();
+        }
+    }
+    return reinterpret_cast<const char *>(m_map);
+}
+
+qint64 LogView::lineEnd(int line) const
+{
+    // Excluding the newline
+    return line + 1 < lineCount() ? m_lineStarts.at(line + 1) - 1 : m_size;
+}
+
+int LogView::lineAt(qint64 offset) const
+{
+    auto it = std::upper_bound(m_lineStarts.cbegin(), m_lineStarts.cend(), offset);
+    return int(it - m_lineStarts.cbegin()) - 1;
+}
+
+int LogView::lineAtY(int y) const
+{
+    int line = verticalScrollBar()->value() + qMax(0, y) / lineHeight();
+    return qBound(0, line, lineCount() - 1);
+}
+
+int LogView::lineHeight() const
+{
+    return fontMetrics().height();
+}
+
+int LogView::charWidth() const
+{
+    return qMax(1, fontMetrics().horizontalAdvance(QLatin1Char('x')));
+}
+
+int LogView::visibleLines() const
+{
+    return qMax(1, viewport()->height() / lineHeight());
+}
+
+void LogView::updateScrollBars()
+{
+    int pageLines = visibleLines();
+    verticalScrollBar()->setRange(0, qMax(0, lineCount() - pageLines));
+    verticalScrollBar()->setPageStep(pageLines);
+    verticalScrollBar()->setSingleStep(1);
+
+    int width = int(qMin(m_longestLine, maxColumns)) * charWidth() + 2 * margin;
+    horizontalScrollBar()->setRange(0, qMax(0, width - viewport()->width()));
+    horizontalScrollBar()->setPageStep(viewport()->width());
+    horizontalScrollBar()->setSingleStep(charWidth());
+}
+
+void LogView::updateMinimap()
+{
+    bool visible = !m_needle.isEmpty();
+    setViewportMargins(0, 0, visible ? minimapWidth : 0, 0);
+    m_minimap->setVisible(visible);
+    if (visible) {
+        QRect rect = viewport()->geometry();
+        m_minimap->setGeometry(rect.right() + 1, rect.top(), minimapWidth, rect.height());
+        m_minimap->update();
+    }
+}
+
+void LogView::paintMinimap()
+{
+    QPainter painter(m_minimap);
+    const int height = m_minimap->height();
+    const int lines = lineCount();
+    painter.fillRect(m_minimap->rect(), palette().alternateBase());
+
+    // Visible part of the log
+    int top = int(qint64(verticalScrollBar()->value()) * height / lines);
+    int bottom = int(qint64(verticalScrollBar()->value() + visibleLines()) * height / lines);
+    painter.fillRect(0, top, minimapWidth, qMax(1, bottom - top), palette().midlight());
+
+    // One mark per pixel row which has matches; matches and lines are both sorted
+    const QColor markColor(255, 200, 0);
+    int line = 0;
+    int lastRow = -1;
+    for (qint64 offset : std::as_const(m_matches)) {
+        while (line + 1 < lines && m_lineStarts.at(line + 1) <= offset) {
+            line++;
+        }
+        int row = int(qint64(line) * height / lines);
+        if (row != lastRow) {
+            painter.fillRect(2, row, minimapWidth - 4, 2, markColor);
+            lastRow = row;
+        }
+    }
+
+    if (m_matchOffset >= 0) {
+        int row = int(qint64(lineAt(m_matchOffset)) * height / lines);
+        painter.fillRect(0, row - 1, minimapWidth, 3, palette().highlight());
+    }
+}
+
+void LogView::copySelection()
+{
+    const char *data = mappedData();
+    if (!data || m_selectionAnchor < 0) {
+        return;
+    }
+
+    qint64 start = m_lineStarts.at(qMin(m_selectionAnchor, m_selectionEnd));
+    qint64 end = lineEnd(qMax(m_selectionAnchor, m_selectionEnd));
+    QGuiApplication::clipboard()->setText(QString::fromUtf8(data + start, end - start));
+}
+
+QString LogView::expandTabs(const QString &text)
+{
+    if (!text.contains('\t')) {
+        return text;
+    }
+
+    QString expanded;
+    expanded.reserve(text.size() + tabWidth);
+    for (QChar c : text) {
+        if (c == '\t') {
+            expanded.append(QString(tabWidth - expanded.size() % tabWidth, ' '));
+        } else {
+            expanded.append(c);
+        }
+    }
+    return expanded;
+}
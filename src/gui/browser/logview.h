@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOGVIEW_H
+#define LOGVIEW_H
+
+#include <QAbstractScrollArea>
+#include <QTemporaryFile>
+#include <QVector>
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <QMouseEvent>
+#include <QKeyEvent>
+
+/*
+ * Read-only view for (very) large logs.
+ *
+ * The log is spooled to a temporary file which is memory-mapped, and
+ * only the offset at which each line starts is kept in memory. Lines
+ * are decoded when they are painted, so opening or scrolling a log
+ * costs the same whatever its size.
+ *
+ * Offsets, matches and selections are in bytes of the UTF-8 log.
+ * Setting a search text collects the offsets of all its matches
+ * (see LogSearch), which give the match count, the minimap next to
+ * the scroll bar and find next/previous. Highlighting only scans the
+ * visible lines.
+ *
+ */
+class LogView : public QAbstractScrollArea
+{
+    Q_OBJECT
+
+public:
+    explicit LogView(QWidget *parent = nullptr);
+    ~LogView();
+    void clear();
+    bool appendData(const QByteArray &data);
+    qint64 size() const;
+    QString getFileName() const;
+    int lineCount() const;
+    QString getLine(int line);
+    int setSearchText(const QString &text);
+    bool find(const QString &text, bool backward);
+    int getMatchCount() const;
+    bool isMatchCountExact() const;
+    int getCurrentMatch() const;
+    void clearMatch();
+    void setHighlightMatches(bool highlight);
+    void scrollToLine(int line);
+    void selectLine(int line);
+    void scrollToBottom();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void scrollContentsBy(int dx, int dy) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void keyPressEvent(QKeyEvent *event) override;
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+signals:
+    void matchesChanged();
+
+private:
+    QTemporaryFile m_file;
+    uchar *m_map;
+    qint64 m_mappedSize;
+    qint64 m_size;
+    QVector<qint64> m_lineStarts;
+    qint64 m_longestLine;
+    QByteArray m_needle;
+    QVector<qint64> m_matches;
+    bool m_matchesTruncated;
+    qint64 m_matchOffset;
+    bool m_highlightMatches;
+    QWidget *m_minimap;
+    int m_selectionAnchor;
+    int m_selectionEnd;
+    const char *mappedData();
+    qint64 lineEnd(int line) const;
+    int lineAt(qint64 offset) const;
+    int lineAtY(int y) const;
+    int lineHeight() const;
+    int charWidth() const;
+    int visibleLines() const;
+    void updateScrollBars();
+    void copySelection();
+    void updateMinimap();
+    void paintMinimap();
+    static QString expandTabs(const QString &text);
+};
+
+#endif // LOGVIEW_H
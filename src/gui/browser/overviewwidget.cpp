@@ -80,9 +80,9 @@ void OverviewWidget::setPackageCount(const QString &packageCount)
     ui->packagesCount->setText(packageCount);
 }
 
-void OverviewWidget::addResult(QSharedPointer<OBSResult> result)
+void OverviewWidget::addResults(const OBSResultSet &resultSet, const QString &project, const QString &package)
 {
-    ui->resultsWidget->addResult(result);
+    ui->resultsWidget->addResults(resultSet, project, package);
 }
 
 QString OverviewWidget::getCurrentRepository() const
@@ -24,6 +24,7 @@
 #include "datacontroller.h"
 #include "obsmetaconfig.h"
 #include "obsresult.h"
+#include "obsresultset.h"
 #include "obsrevision.h"
 
 namespace Ui {
@@ -41,7 +42,7 @@ public:
     void setResultsMenu(QMenu *resultsMenu);
     void setLatestRevision(QSharedPointer<OBSRevision> revision);
     void setPackageCount(const QString &packageCount);
-    void addResult(QSharedPointer<OBSResult> result);
+    void addResults(const OBSResultSet &resultSet, const QString &project, const QString &package);
     QString getCurrentRepository() const;
     QString getCurrentArch() const;
     QList<OBSResult> getBuilds() const;
@@ -59,7 +60,7 @@ private:
 
 signals:
     void buildResultSelectionChanged();
-    void finishedParsingResultList(QList<QSharedPointer<OBSResult>> resultList);
+    void finishedParsingResultList(OBSResultSet resultSet);
     void updateStatusBar(const QString &message, bool progressBarHidden);
 
 public slots:
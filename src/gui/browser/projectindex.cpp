@@ -0,0 +1,403 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "projectindex.h"
+#include <QDebug>
+#include <QRegularExpression>
+#include <QSet>
+#include <algorithm>
+#include <tuple>
+
+ProjectIndex::ProjectIndex() :
+    m_removed(0)
+{
+
+}
+
+QStringList ProjectIndex::getProjects() const
+{
+    QStringList projects;
+    projects.reserve(m_sorted.size());
+    for (int id : m_sorted) {
+        projects.append(m_names.at(id));
+    }
+    return projects;
+}
+
+int ProjectIndex::size() const
+{
+    return m_sorted.size();
+}
+
+bool ProjectIndex::contains(const QString &project) const
+{
+    return findSorted(project) != -1;
+}
+
+void ProjectIndex::setProjects(const QStringList &projects)
+{
+// Sorted by (lower case name, name), like m_sorted
+    QVector<QPair<QString, QString>> sorted;
+    sorted.reserve(projects.size());
+    foreach (const QString &project, projects) {
+        if (!project.isEmpty()) {
+            sorted.append(qMakePair(project.toLower(), project));
+        }
+    }
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    if (m_sorted.isEmpty()) {
+        rebuild(sorted);
+        return;
+    }
+
+// Both lists are sorted, so the diff is a single merge pass
+    QStringList added;
+    QStringList removed;
+    int i = 0;
+    int j = 0;
+    while (i < m_sorted.size() || j < sorted.size()) {
+        QPair<QString, QString> current;
+        if (i < m_sorted.size()) {
+            current = qMakePair(m_keys.at(m_sorted.at(i)), m_names.at(m_sorted.at(i)));
+        }
+        if (j == sorted.size() || (i < m_sorted.size() && current < sorted.at(j))) {
+            removed.append(current.second);
+            i++;
+        } else if (i == m_sorted.size() || sorted.at(j) < current) {
+            added.append(sorted.at(j).second);
+            j++;
+        } else {
+            i++;
+            j++;
+        }
+    }
+    qDebug() << Q_FUNC_INFO << "Added:" << added.size() << "Removed:" << removed.size();
+
+    if (added.size() + removed.size() > m_sorted.size() / 2) {
+        rebuild(sorted);
+        return;
+    }
+
+    foreach (const QString &project, removed) {
+        removeProject(project);
+    }
+    foreach (const QString &project, added) {
+        addProject(project);
+    }
+}
+
+bool ProjectIndex::addProject(const QString &project)
+{
+    if (project.isEmpty() || contains(project)) {
+        return false;
+    }
+
+    int id = appendName(project);
+    auto it = std::upper_bound(m_sorted.begin(), m_sorted.end(), id, [this](int a, int b) {
+        return std::tie(m_keys.at(a), m_names.at(a)) < std::tie(m_keys.at(b), m_names.at(b));
+    });
+    m_sorted.insert(it, id);
+
+    const QString &key = m_keys.at(id);
+    for (int offset = key.indexOf(':'); offset != -1; offset = key.indexOf(':', offset + 1)) {
+        if (offset + 1 < key.size()) {
+            QStringView suffix = QStringView(key).mid(offset + 1);
+            auto segmentIt = std::upper_bound(m_segments.begin(), m_segments.end(), suffix,
+                                              [this](QStringView a, const Segment &b) {
+                return a.compare(QStringView(m_keys.at(b.id)).mid(b.offset)) < 0;
+            });
+            m_segments.insert(segmentIt, Segment{id, offset + 1});
+        }
+    }
+    indexTrigrams(id);
+    return true;
+}
+
+bool ProjectIndex::removeProject(const QString &project)
+{
+    int id = findSorted(project);
+    if (id == -1) {
+        return false;
+    }
+
+    m_sorted.removeOne(id);
+    const QString &key = m_keys.at(id);
+    for (int offset = key.indexOf(':'); offset != -1; offset = key.indexOf(':', offset + 1)) {
+        if (offset + 1 < key.size()) {
+            QStringView suffix = QStringView(key).mid(offset + 1);
+            for (auto it = segmentLowerBound(suffix); it != m_segments.cend(); ++it) {
+                if (it->id == id && it->offset == offset + 1) {
+                    m_segments.erase(it);
+                    break;
+                }
+                if (QStringView(m_keys.at(it->id)).mid(it->offset) != suffix) {
+                    break;
+                }
+            }
+        }
+    }
+
+// Trigram postings are left as they are, lookups skip removed ids
+    m_names[id].clear();
+    m_keys[id].clear();
+    m_removed++;
+
+    if (m_removed > m_names.size() / 4) {
+        QVector<QPair<QString, QString>> sorted;
+        sorted.reserve(m_sorted.size());
+        for (int sortedId : std::as_const(m_sorted)) {
+            sorted.append(qMakePair(m_keys.at(sortedId), m_names.at(sortedId)));
+        }
+        rebuild(sorted);
+    }
+    return true;
+}
+
+QStringList ProjectIndex::find(const QString &text, int limit) const
+{
+    QStringList result;
+    QString key = text.trimmed().toLower();
+    if (key.isEmpty() || limit <= 0) {
+        return result;
+    }
+
+    if (key.contains('*') || key.contains('?')) {
+        findWildcard(key, limit, result);
+        return result;
+    }
+
+    QSet<int> found;
+
+// Prefix matches first
+    for (auto it = lowerBound(key); it != m_sorted.cend() && result.size() < limit; ++it) {
+        if (!m_keys.at(*it).startsWith(key)) {
+            break;
+        }
+        found.insert(*it);
+        result.append(m_names.at(*it));
+    }
+
+// Then matches at the start of a segment
+    for (auto it = segmentLowerBound(key); it != m_segments.cend() && result.size() < limit; ++it) {
+        if (!QStringView(m_keys.at(it->id)).mid(it->offset).startsWith(key)) {
+            break;
+        }
+        if (!found.contains(it->id)) {
+            found.insert(it->id);
+            result.append(m_names.at(it->id));
+        }
+    }
+
+// And finally any other substring
+    if (key.size() >= 3 && result.size() < limit) {
+        const QVector<int> candidates = findCandidates(key);
+        for (int id : candidates) {
+            if (result.size() >= limit) {
+                break;
+            }
+            if (!found.contains(id) && m_keys.at(id).contains(key)) {
+                found.insert(id);
+                result.append(m_names.at(id));
+            }
+        }
+    }
+
+    return result;
+}
+
+void ProjectIndex::clear()
+{
+    m_names.clear();
+    m_keys.clear();
+    m_sorted.clear();
+    m_segments.clear();
+    m_trigrams.clear();
+    m_removed = 0;
+}
+
+void ProjectIndex::rebuild(const QVector<QPair<QString, QString>> &projects)
+{
+    clear();
+    m_names.reserve(projects.size());
+    m_keys.reserve(projects.size());
+    m_sorted.reserve(projects.size());
+
+// projects is sorted, so ids are assigned in order
+    for (const QPair<QString, QString> &project : projects) {
+        int id = appendName(project.second);
+        m_sorted.append(id);
+
+        const QString &key = m_keys.at(id);
+        for (int offset = key.indexOf(':'); offset != -1; offset = key.indexOf(':', offset + 1)) {
+            if (offset + 1 < key.size()) {
+                m_segments.append(Segment{id, offset + 1});
+            }
+        }
+        indexTrigrams(id);
+    }
+
+    std::sort(m_segments.begin(), m_segments.end(), [this](const Segment &a, const Segment &b) {
+        return QStringView(m_keys.at(a.id)).mid(a.offset).compare(QStringView(m_keys.at(b.id)).mid(b.offset)) < 0;
+    });
+}
+
+int ProjectIndex::appendName(const QString &project)
+{
+    m_names.append(project);
+    m_keys.append(project.toLower());
+    return m_names.size() - 1;
+}
+
+void ProjectIndex::indexTrigrams(int id)
+{
+    const QString &key = m_keys.at(id);
+    for (int pos = 0; pos + 3 <= key.size(); ++pos) {
+        QVector<int> &postings = m_trigrams[trigram(key, pos)];
+// Ids only grow, so postings stay sorted
+        if (postings.isEmpty() || postings.last() != id) {
+            postings.append(id);
+        }
+    }
+}
+
+int ProjectIndex::findSorted(const QString &project) const
+{
+    QString key = project.toLower();
+    for (auto it = lowerBound(key); it != m_sorted.cend(); ++it) {
+        if (m_keys.at(*it) != key) {
+            break;
+        }
+        if (m_names.at(*it) == project) {
+            return *it;
+        }
+    }
+    return -1;
+}
+
+QVector<int>::const_iterator ProjectIndex::lowerBound(const QString &key) const
+{
+    return std::lower_bound(m_sorted.cbegin(), m_sorted.cend(), key, [this](int id, const QString &key) {
+        return m_keys.at(id) < key;
+    });
+}
+
+QVector<ProjectIndex::Segment>::const_iterator ProjectIndex::segmentLowerBound(QStringView key) const
+{
+    return std::lower_bound(m_segments.cbegin(), m_segments.cend(), key, [this](const Segment &segment, QStringView key) {
+        return QStringView(m_keys.at(segment.id)).mid(segment.offset).compare(key) < 0;
+    });
+}
+
+QVector<int> ProjectIndex::findCandidates(QStringView key) const
+{
+    QList<const QVector<int> *> lists;
+    for (int pos = 0; pos + 3 <= key.size(); ++pos) {
+        auto it = m_trigrams.constFind(trigram(key, pos));
+        if (it == m_trigrams.constEnd()) {
+            return QVector<int>();
+        }
+        lists.append(&it.value());
+    }
+
+    std::sort(lists.begin(), lists.end(), [](const QVector<int> *a, const QVector<int> *b) {
+        return a->size() < b->size();
+    });
+
+// Intersect, starting from the shortest posting list
+    QVector<int> candidates;
+    for (int id : *lists.first()) {
+        bool inAll = true;
+        for (int i = 1; i < lists.size() && inAll; ++i) {
+            inAll = std::binary_search(lists.at(i)->cbegin(), lists.at(i)->cend(), id);
+        }
+        if (inAll) {
+            candidates.append(id);
+        }
+    }
+    return candidates;
+}
+
+/*
+ * A wildcard pattern has to match either the whole project name or
+ * the part after a ':', so "languages:*" finds "devel:languages:perl".
+ * The literal text before the first wildcard narrows down the ids to
+ * check; the longest literal chunk is used if the pattern begins with
+ * a wildcard.
+ *
+ */
+void ProjectIndex::findWildcard(const QString &key, int limit, QStringList &result) const
+{
+    QRegularExpression regExp(QRegularExpression::wildcardToRegularExpression(key));
+    QSet<int> found;
+
+    auto match = [&](int id, QStringView text) {
+        if (!found.contains(id) && regExp.match(text.toString()).hasMatch()) {
+            found.insert(id);
+            result.append(m_names.at(id));
+        }
+    };
+
+    static const QRegularExpression wildcardRegExp("[*?\\[]");
+    QString prefix = key.left(key.indexOf(wildcardRegExp));
+
+    if (!prefix.isEmpty()) {
+        for (auto it = lowerBound(prefix); it != m_sorted.cend() && result.size() < limit; ++it) {
+            if (!m_keys.at(*it).startsWith(prefix)) {
+                break;
+            }
+            match(*it, m_keys.at(*it));
+        }
+        for (auto it = segmentLowerBound(prefix); it != m_segments.cend() && result.size() < limit; ++it) {
+            QStringView suffix = QStringView(m_keys.at(it->id)).mid(it->offset);
+            if (!suffix.startsWith(prefix)) {
+                break;
+            }
+            match(it->id, suffix);
+        }
+        return;
+    }
+
+    QString longestChunk;
+    const QStringList chunks = key.split(wildcardRegExp, Qt::SkipEmptyParts);
+    foreach (const QString &chunk, chunks) {
+        if (chunk.size() > longestChunk.size()) {
+            longestChunk = chunk;
+        }
+    }
+
+    QVector<int> candidates = longestChunk.size() >= 3 ? findCandidates(longestChunk) : m_sorted;
+    for (int id : candidates) {
+        if (result.size() >= limit) {
+            break;
+        }
+        const QString &name = m_keys.at(id);
+        if (name.isEmpty()) {
+            continue;
+        }
+        match(id, name);
+        for (int offset = name.indexOf(':'); offset != -1 && !found.contains(id); offset = name.indexOf(':', offset + 1)) {
+            match(id, QStringView(name).mid(offset + 1));
+        }
+    }
+}
+
+quint64 ProjectIndex::trigram(QStringView key, int pos)
+{
+    return (quint64(key.at(pos).unicode()) << 32) |
+            (quint64(key.at(pos + 1).unicode()) << 16) |
+            quint64(key.at(pos + 2).unicode());
+}
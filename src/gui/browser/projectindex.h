@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PROJECTINDEX_H
+#define PROJECTINDEX_H
+
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QPair>
+
+/*
+ * Searchable index of project names used by the location bar.
+ *
+ * Projects get a stable id (their position in m_names). Lookups are
+ * done on three sorted/hashed views of the lower case names:
+ * - m_sorted: ids sorted by name, for prefix matches
+ * - m_segments: suffixes starting after each ':', for segment matches
+ *   (e.g. "languages:py" finds "devel:languages:python")
+ * - m_trigrams: posting lists of ids, for substring matches
+ *
+ * Removed projects leave a hole in m_names which is skipped by lookups;
+ * the index is rebuilt when there are too many of them.
+ *
+ */
+class ProjectIndex
+{
+public:
+    ProjectIndex();
+    QStringList getProjects() const;
+    int size() const;
+    bool contains(const QString &project) const;
+    void setProjects(const QStringList &projects);
+    bool addProject(const QString &project);
+    bool removeProject(const QString &project);
+    QStringList find(const QString &text, int limit) const;
+
+private:
+    struct Segment {
+        int id;
+        int offset;
+    };
+    QStringList m_names;
+    QStringList m_keys;
+    QVector<int> m_sorted;
+    QVector<Segment> m_segments;
+    QHash<quint64, QVector<int>> m_trigrams;
+    int m_removed;
+    void clear();
+    void rebuild(const QVector<QPair<QString, QString>> &projects);
+    int appendName(const QString &project);
+    void indexTrigrams(int id);
+    int findSorted(const QString &key) const;
+    QVector<int>::const_iterator lowerBound(const QString &key) const;
+    QVector<Segment>::const_iterator segmentLowerBound(QStringView key) const;
+    QVector<int> findCandidates(QStringView key) const;
+    void findWildcard(const QString &key, int limit, QStringList &result) const;
+    static quint64 trigram(QStringView key, int pos);
+};
+
+#endif // PROJECTINDEX_H
@@ -17,6 +17,7 @@
 #include <QDateTime>
 #include <QHeaderView>
 #include <QTimeZone>
+#include "utils.h"
 
 RevisionTreeWidget::RevisionTreeWidget(QWidget *parent) :
     QTreeView(parent),
@@ -77,42 +78,52 @@ QString RevisionTreeWidget::getPackage() const
     return package;
 }
 
-void RevisionTreeWidget::addRevision(QSharedPointer<OBSRevision> revision)
+void RevisionTreeWidget::addRevisions(QList<QSharedPointer<OBSRevision>> revisionList)
 {
     QStandardItemModel *itemModel = static_cast<QStandardItemModel *>(model());
     if (itemModel) {
         itemModel->setSortRole(Qt::UserRole);
 
-        QStandardItem *revItem = new QStandardItem();
-        revItem->setData(revision->getRev(), Qt::UserRole);
-        revItem->setData(revision->getRev(), Qt::DisplayRole);
-        revItem->setData(Qt::AlignTop, Qt::TextAlignmentRole);
-
-        QStandardItem *dateItem = new QStandardItem();
-        QString dateStr;
-        uint unixTime = revision->getTime();
-        QDateTime dateTime = QDateTime::fromSecsSinceEpoch(qint64(unixTime), QTimeZone::UTC);
-        dateStr = dateTime.toString("dd/MM/yyyy H:mm");
-        dateItem->setData(unixTime, Qt::UserRole);
-        dateItem->setData(dateStr, Qt::DisplayRole);
-        dateItem->setData(Qt::AlignTop, Qt::TextAlignmentRole);
-
-        QStandardItem *userItem = new QStandardItem();
-        userItem->setData(revision->getUser(), Qt::UserRole);
-        userItem->setData(revision->getUser(), Qt::DisplayRole);
-        userItem->setData(Qt::AlignTop, Qt::TextAlignmentRole);
-
-        QStandardItem *commentsItem = new QStandardItem();
-        commentsItem->setData(revision->getComment(), Qt::UserRole);
-        commentsItem->setData(revision->getComment(), Qt::DisplayRole);
-        commentsItem->setData(Qt::AlignTop, Qt::TextAlignmentRole);
-
-        QList<QStandardItem *> items;
-        items << revItem << dateItem << userItem << commentsItem;
-        itemModel->appendRow(items);
+        QList<QList<QStandardItem *>> rows;
+        rows.reserve(revisionList.size());
+        foreach (QSharedPointer<OBSRevision> revision, revisionList) {
+            rows.append(revisionToItems(revision));
+        }
+        Utils::appendRows(itemModel, rows);
     }
 }
 
+QList<QStandardItem *> RevisionTreeWidget::revisionToItems(QSharedPointer<OBSRevision> revision)
+{
+    QStandardItem *revItem = new QStandardItem();
+    revItem->setData(revision->getRev(), Qt::UserRole);
+    revItem->setData(revision->getRev(), Qt::DisplayRole);
+    revItem->setData(Qt::AlignTop, Qt::TextAlignmentRole);
+
+    QStandardItem *dateItem = new QStandardItem();
+    QString dateStr;
+    uint unixTime = revision->getTime();
+    QDateTime dateTime = QDateTime::fromSecsSinceEpoch(qint64(unixTime), QTimeZone::UTC);
+    dateStr = dateTime.toString("dd/MM/yyyy H:mm");
+    dateItem->setData(unixTime, Qt::UserRole);
+    dateItem->setData(dateStr, Qt::DisplayRole);
+    dateItem->setData(Qt::AlignTop, Qt::TextAlignmentRole);
+
+    QStandardItem *userItem = new QStandardItem();
+    userItem->setData(revision->getUser(), Qt::UserRole);
+    userItem->setData(revision->getUser(), Qt::DisplayRole);
+    userItem->setData(Qt::AlignTop, Qt::TextAlignmentRole);
+
+    QStandardItem *commentsItem = new QStandardItem();
+    commentsItem->setData(revision->getComment(), Qt::UserRole);
+    commentsItem->setData(revision->getComment(), Qt::DisplayRole);
+    commentsItem->setData(Qt::AlignTop, Qt::TextAlignmentRole);
+
+    QList<QStandardItem *> items;
+    items << revItem << dateItem << userItem << commentsItem;
+    return items;
+}
+
 void RevisionTreeWidget::revisionsAdded(const QString &project, const QString &package)
 {
     if (firstTimeRevisionListDisplayed) {
@@ -42,9 +42,10 @@ private:
     Qt::SortOrder order;
     QString project;
     QString package;
+    QList<QStandardItem *> revisionToItems(QSharedPointer<OBSRevision> revision);
 
 public slots:
-    void addRevision(QSharedPointer<OBSRevision> revision);
+    void addRevisions(QList<QSharedPointer<OBSRevision>> revisionList);
     void revisionsAdded(const QString &project, const QString &package);
 
 signals:
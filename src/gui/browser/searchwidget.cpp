@@ -16,10 +16,10 @@
 #include "searchwidget.h"
 #include "ui_searchwidget.h"
 
-SearchWidget::SearchWidget(QWidget *parent, QPlainTextEdit *plainTextEdit) :
+SearchWidget::SearchWidget(QWidget *parent, LogView *logView) :
     QWidget(parent),
     ui(new Ui::SearchWidget),
-    m_plainTextEdit(plainTextEdit)
+    m_logView(logView)
 {
     ui->setupUi(this);
     setAttribute(Qt::WA_DeleteOnClose);
@@ -34,16 +34,12 @@ SearchWidget::SearchWidget(QWidget *parent, QPlainTextEdit *plainTextEdit) :
     connect(ui->pushButtonNext, &QPushButton::clicked, this, &SearchWidget::findNext);
     connect(ui->pushButtonPrevious, &QPushButton::clicked, this, &SearchWidget::findPrevious);
     connect(ui->lineEdit, &QLineEdit::textEdited, this, QOverload<const QString &>::of(&SearchWidget::clearAll));
+    connect(ui->lineEdit, &QLineEdit::textEdited, this, &SearchWidget::search);
+    connect(m_logView, &LogView::matchesChanged, this, &SearchWidget::updateMatchCount);
     connect(ui->lineEdit, &QLineEdit::returnPressed, this, &SearchWidget::findNext);
     connect(ui->pushButtonHighlight, &QPushButton::toggled, this, &SearchWidget::highlightText);
     connect(ui->pushButtonClose, &QPushButton::clicked, this, QOverload<>::of(&SearchWidget::clearAll));
     connect(ui->pushButtonClose, &QPushButton::clicked, this, &SearchWidget::close);
-
-    QTextCursor cursor = m_plainTextEdit->textCursor();
-    cursor.movePosition(QTextCursor::End);
-    m_plainTextEdit->setTextCursor(cursor);
-
-    logHighlighter = nullptr;
 }
 
 SearchWidget::~SearchWidget()
@@ -59,17 +55,17 @@ void SearchWidget::setup()
 
 void SearchWidget::findNext()
 {
-    findText(ui->lineEdit->text(), QTextDocument::FindFlags());
+    findText(ui->lineEdit->text(), false);
 }
 
 void SearchWidget::findPrevious()
 {
-    findText(ui->lineEdit->text(), QTextDocument::FindBackward);
+    findText(ui->lineEdit->text(), true);
 }
 
-void SearchWidget::findText(const QString &text, QTextDocument::FindFlags findFlags)
+void SearchWidget::findText(const QString &text, bool backward)
 {
-    bool found = m_plainTextEdit->find(text, findFlags);
+    bool found = m_logView->find(text, backward);
     highlightText(ui->pushButtonHighlight->isChecked());
 
     if (text.isEmpty()) {
@@ -86,34 +82,19 @@ void SearchWidget::setLineEditStyle(bool found)
 
 void SearchWidget::clearHighlight()
 {
-    if (logHighlighter) {
-        delete logHighlighter;
-        logHighlighter = nullptr;
-        lastSearch = "";
-    }
+    m_logView->setHighlightMatches(false);
 }
 
 void SearchWidget::clearSelection()
 {
-    QTextCursor cursor = m_plainTextEdit->textCursor();
-    cursor.movePosition(QTextCursor::EndOfWord);
-    m_plainTextEdit->setTextCursor(cursor);
+    m_logView->clearMatch();
     ui->lineEdit->setStyleSheet("");
 }
 
 void SearchWidget::highlightText(bool check)
 {
     if (check) {
-        if (!logHighlighter) {
-            logHighlighter = new LogHighlighter(m_plainTextEdit->document(), ui->lineEdit->text());
-            lastSearch = ui->lineEdit->text();
-        } else {
-            if (ui->lineEdit->text()!=lastSearch) {
-                delete logHighlighter;
-                logHighlighter = new LogHighlighter(m_plainTextEdit->document(), ui->lineEdit->text());
-                lastSearch = ui->lineEdit->text();
-            }
-        }
+        m_logView->setHighlightMatches(true);
     } else {
         clearHighlight();
     }
@@ -123,6 +104,7 @@ void SearchWidget::clearAll()
 {
     clearHighlight();
     clearSelection();
+    m_logView->setSearchText(QString());
 }
 
 void SearchWidget::clearAll(const QString &text)
@@ -132,6 +114,30 @@ void SearchWidget::clearAll(const QString &text)
     }
 }
 
+// Matches are counted as the text is typed
+void SearchWidget::search(const QString &text)
+{
+    m_logView->setSearchText(text);
+    highlightText(ui->pushButtonHighlight->isChecked());
+}
+
+void SearchWidget::updateMatchCount()
+{
+    int count = m_logView->getMatchCount();
+    if (ui->lineEdit->text().isEmpty()) {
+        ui->labelMatches->clear();
+        return;
+    }
+
+    QString total = QString::number(count) + (m_logView->isMatchCountExact() ? "" : "+");
+    int current = m_logView->getCurrentMatch();
+    if (current >= 0) {
+        ui->labelMatches->setText(tr("%1 of %2").arg(current + 1).arg(total));
+    } else {
+        ui->labelMatches->setText(tr("%1 matches").arg(total));
+    }
+}
+
 void SearchWidget::keyPressEvent(QKeyEvent *event)
 {
     if (event->key() == Qt::Key_Escape) {
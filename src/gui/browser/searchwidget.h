@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Javier Llorente <javier@opensuse.org>
+ * Copyright (C) 2018-2025 Javier Llorente <javier@opensuse.org>
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -17,11 +17,9 @@
 #define SEARCHWIDGET_H
 
 #include <QWidget>
-#include <QPlainTextEdit>
-#include <QTextDocument>
 #include <QShortcut>
 #include <QKeyEvent>
-#include "loghighlighter.h"
+#include "logview.h"
 
 namespace Ui {
 class SearchWidget;
@@ -32,7 +30,7 @@ class SearchWidget : public QWidget
     Q_OBJECT
 
 public:
-    explicit SearchWidget(QWidget *parent = nullptr, QPlainTextEdit *plainTextEdit = nullptr);
+    explicit SearchWidget(QWidget *parent = nullptr, LogView *logView = nullptr);
     ~SearchWidget();
     void setup();
 
@@ -42,13 +40,13 @@ private slots:
     void highlightText(bool check);
     void clearAll();
     void clearAll(const QString &text);
+    void search(const QString &text);
+    void updateMatchCount();
 
 private:
     Ui::SearchWidget *ui;
-    QPlainTextEdit *m_plainTextEdit;
-    LogHighlighter *logHighlighter;
-    QString lastSearch;
-    void findText(const QString &text, QTextDocument::FindFlags findFlags);
+    LogView *m_logView;
+    void findText(const QString &text, bool backward);
     void setLineEditStyle(bool found);
     void clearHighlight();
     void clearSelection();
@@ -93,6 +93,7 @@ void Configure::writeSettings()
     settings.beginGroup("Timer");
     settings.setValue("Active", ui->checkBoxTimer->isChecked());
     settings.setValue("Value", ui->spinBoxTimer->value());
+    settings.setValue("Watch", ui->checkBoxWatch->isChecked());
     settings.endGroup();
 
     settings.beginGroup("Browser");
@@ -224,6 +225,7 @@ void Configure::readTimerSettings()
     settings.beginGroup("Timer");
     ui->checkBoxTimer->setChecked(settings.value("Active").toBool());
     ui->spinBoxTimer->setValue(settings.value("Value").toInt());
+    ui->checkBoxWatch->setChecked(settings.value("Watch", true).toBool());
     settings.endGroup();
 }
 
@@ -821,6 +821,7 @@ void MainWindow::readTimerSettings()
             qDebug() << "MainWindow::readSettingsTimer() Timer has been stopped";
         }
     }
+    monitor->setWatchEnabled(settings.value("Watch", true).toBool());
     settings.endGroup();
 }
 
@@ -21,7 +21,8 @@
 Monitor::Monitor(QWidget *parent, OBS *obs) :
     QWidget(parent),
     ui(new Ui::Monitor),
-    m_obs(obs)
+    m_obs(obs),
+    m_watchEnabled(false)
 {
     ui->setupUi(this);
 
@@ -55,6 +56,14 @@ void Monitor::refresh()
     }
 }
 
+void Monitor::setWatchEnabled(bool enabled)
+{
+    m_watchEnabled = enabled;
+    for (int i=0; i<ui->tabWidget->count(); i++) {
+        dynamic_cast<MonitorTab *>(ui->tabWidget->widget(i))->setWatchEnabled(enabled);
+    }
+}
+
 bool Monitor::packagesTabContains(const QString &project, const QString &package)
 {
     MonitorPackagesTab *monitorPackagesTab = dynamic_cast<MonitorPackagesTab *>(
@@ -84,6 +93,7 @@ int Monitor::addTab(const QString &title)
     emit updateStatusBar(tr("Adding tab for ") + title + " ...", false);
     MonitorTab *tab = new MonitorRepositoryTab(ui->tabWidget, title, m_obs);
     setupTabConnections(tab);
+    tab->setWatchEnabled(m_watchEnabled);
     return ui->tabWidget->addTab(tab, title);
 }
 
@@ -142,6 +152,7 @@ void Monitor::setupPackagesTab()
 
 void Monitor::closeTab(int index)
 {
+    dynamic_cast<MonitorTab *>(ui->tabWidget->widget(index))->setWatchEnabled(false);
     delete ui->tabWidget->widget(index);
 
     QSettings settings;
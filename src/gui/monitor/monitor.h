@@ -33,6 +33,7 @@ public:
     ~Monitor();
     bool hasPackageSelection();
     void refresh();
+    void setWatchEnabled(bool enabled);
     bool packagesTabContains(const QString &project, const QString &package);
     bool tabWidgetContains(const QString &tabText);
     int addTab(const QString &title);
@@ -41,6 +42,7 @@ public:
 private:
     Ui::Monitor *ui;
     OBS *m_obs;
+    bool m_watchEnabled;
     void readSettings();
     void writeSettings();
     void setupTabConnections(MonitorTab *tab);
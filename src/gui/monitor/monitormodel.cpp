@@ -0,0 +1,356 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "monitormodel.h"
+#include "utils.h"
+#include <QFont>
+#include <algorithm>
+#include <functional>
+
+MonitorModel::MonitorModel(QObject *parent) :
+    QAbstractTableModel(parent)
+{
+
+}
+
+int MonitorModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_projects.size();
+}
+
+int MonitorModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant MonitorModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_projects.size()) {
+        return QVariant();
+    }
+    const int row = index.row();
+
+    switch (role) {
+    case Qt::DisplayRole:
+        switch (index.column()) {
+        case ProjectColumn:
+            return m_strings.at(m_projects.at(row));
+        case PackageColumn:
+            return m_strings.at(m_packages.at(row));
+        case RepositoryColumn:
+            return m_strings.at(m_repositories.at(row));
+        case ArchColumn:
+            return m_strings.at(m_archs.at(row));
+        case StatusColumn:
+            return m_strings.at(m_statuses.at(row));
+        }
+        break;
+    case Qt::ToolTipRole:
+        if (index.column() == StatusColumn && !m_details.at(row).isEmpty()) {
+            return m_details.at(row);
+        }
+        break;
+    case Qt::ForegroundRole:
+        if (index.column() == StatusColumn) {
+            return Utils::getColorForStatus(m_strings.at(m_statuses.at(row)));
+        }
+        break;
+    case Qt::FontRole:
+        if (m_changed.at(row)) {
+            QFont font;
+            font.setBold(true);
+            return font;
+        }
+        break;
+    }
+    return QVariant();
+}
+
+QVariant MonitorModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    switch (section) {
+    case ProjectColumn:
+        return tr("Project");
+    case PackageColumn:
+        return tr("Package");
+    case RepositoryColumn:
+        return tr("Repository");
+    case ArchColumn:
+        return tr("Arch");
+    case StatusColumn:
+        return tr("Status");
+    }
+    return QVariant();
+}
+
+Qt::ItemFlags MonitorModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid()) {
+        return Qt::NoItemFlags;
+    } else {
+        return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+    }
+}
+
+bool MonitorModel::removeRows(int row, int count, const QModelIndex &parent)
+{
+    if (parent.isValid() || row < 0 || count <= 0 || row + count > m_projects.size()) {
+        return false;
+    }
+
+    removeRowRange(row, count);
+    updateRowIndex();
+    return true;
+}
+
+int MonitorModel::addRow(const QString &project, const QString &package, const QString &repository,
+                         const QString &arch)
+{
+    const int row = m_projects.size();
+    beginInsertRows(QModelIndex(), row, row);
+    m_projects.append(m_strings.intern(project));
+    m_packages.append(m_strings.intern(package));
+    m_repositories.append(m_strings.intern(repository));
+    m_archs.append(m_strings.intern(arch));
+    m_statuses.append(0);
+    m_details.append(QString());
+    m_changed.append(false);
+    m_rows.insert(getBuild(row), row);
+    endInsertRows();
+    return row;
+}
+
+// Replaces the build of row; its status is cleared
+void MonitorModel::setRow(int row, const QString &project, const QString &package, const QString &repository,
+                          const QString &arch)
+{
+    if (row < 0 || row >= m_projects.size()) {
+        return;
+    }
+
+    m_projects[row] = m_strings.intern(project);
+    m_packages[row] = m_strings.intern(package);
+    m_repositories[row] = m_strings.intern(repository);
+    m_archs[row] = m_strings.intern(arch);
+    m_statuses[row] = 0;
+    m_details[row].clear();
+    m_changed[row] = false;
+    updateRowIndex();
+    emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+}
+
+void MonitorModel::clear()
+{
+    beginResetModel();
+    m_projects.clear();
+    m_packages.clear();
+    m_repositories.clear();
+    m_archs.clear();
+    m_statuses.clear();
+    m_details.clear();
+    m_changed.clear();
+    m_rows.clear();
+    endResetModel();
+}
+
+int MonitorModel::findRow(const QString &project, const QString &package, const QString &repository,
+                          const QString &arch) const
+{
+    Build build = {m_strings.find(project), m_strings.find(package), m_strings.find(repository),
+                   m_strings.find(arch)};
+    return m_rows.value(build, -1);
+}
+
+QString MonitorModel::getProject(int row) const
+{
+    return m_strings.at(m_projects.at(row));
+}
+
+QString MonitorModel::getPackage(int row) const
+{
+    return m_strings.at(m_packages.at(row));
+}
+
+QString MonitorModel::getRepository(int row) const
+{
+    return m_strings.at(m_repositories.at(row));
+}
+
+QString MonitorModel::getArch(int row) const
+{
+    return m_strings.at(m_archs.at(row));
+}
+
+QString MonitorModel::getStatus(int row) const
+{
+    return m_strings.at(m_statuses.at(row));
+}
+
+bool MonitorModel::isComplete(int row) const
+{
+    return m_projects.at(row) && m_packages.at(row) && m_repositories.at(row) && m_archs.at(row);
+}
+
+// Returns false if neither the code nor the details changed
+bool MonitorModel::setStatus(int row, const QString &code, const QString &details)
+{
+    if (row < 0 || row >= m_projects.size()) {
+        return false;
+    }
+
+    int status = m_strings.intern(code);
+    if (m_statuses.at(row) == status && m_details.at(row) == details) {
+        return false;
+    }
+    m_statuses[row] = status;
+    m_details[row] = details;
+    emit dataChanged(index(row, StatusColumn), index(row, StatusColumn));
+    return true;
+}
+
+void MonitorModel::setChanged(int row, bool changed)
+{
+    if (row < 0 || row >= m_projects.size() || m_changed.at(row) == changed) {
+        return;
+    }
+    m_changed[row] = changed;
+    emit dataChanged(index(row, 0), index(row, ColumnCount - 1), QList<int>() << Qt::FontRole);
+}
+
+void MonitorModel::markAllRead()
+{
+    QList<int> rows;
+    for (int row = 0; row < m_changed.size(); row++) {
+        if (m_changed.at(row)) {
+            m_changed[row] = false;
+            rows.append(row);
+        }
+    }
+    emitRowsChanged(rows);
+}
+
+/*
+ * Applies the changes of a result list: changed statuses are updated
+ * in place, removed builds are dropped and added ones appended at
+ * once.
+ *
+ */
+void MonitorModel::applyResultDiff(const OBSResultDiff &diff)
+{
+    QList<int> updatedRows;
+    const QList<OBSResultDiff::Change> changes = diff.getChanged();
+    for (const OBSResultDiff::Change &change : changes) {
+        const OBSResultDiff::Build &build = change.build;
+        int row = findRow(build.project, build.package, build.repository, build.arch);
+        if (row < 0) {
+            continue;
+        }
+        m_statuses[row] = m_strings.intern(change.code);
+        m_details[row] = Utils::breakLine(change.details, 250);
+        updatedRows.append(row);
+    }
+    emitRowsChanged(updatedRows);
+
+    // Removed in runs of consecutive rows, last first
+    QList<int> removedRows;
+    const QList<OBSResultDiff::Change> removed = diff.getRemoved();
+    for (const OBSResultDiff::Change &change : removed) {
+        const OBSResultDiff::Build &build = change.build;
+        int row = findRow(build.project, build.package, build.repository, build.arch);
+        if (row >= 0) {
+            removedRows.append(row);
+        }
+    }
+    if (!removedRows.isEmpty()) {
+        std::sort(removedRows.begin(), removedRows.end(), std::greater<int>());
+        int i = 0;
+        while (i < removedRows.size()) {
+            int last = removedRows.at(i);
+            int first = last;
+            while (++i < removedRows.size() && removedRows.at(i) == first - 1) {
+                first--;
+            }
+            removeRowRange(first, last - first + 1);
+        }
+        updateRowIndex();
+    }
+
+    const QList<OBSResultDiff::Change> added = diff.getAdded();
+    if (!added.isEmpty()) {
+        const int first = m_projects.size();
+        beginInsertRows(QModelIndex(), first, first + added.size() - 1);
+        for (const OBSResultDiff::Change &change : added) {
+            const OBSResultDiff::Build &build = change.build;
+            m_projects.append(m_strings.intern(build.project));
+            m_packages.append(m_strings.intern(build.package));
+            m_repositories.append(m_strings.intern(build.repository));
+            m_archs.append(m_strings.intern(build.arch));
+            m_statuses.append(m_strings.intern(change.code));
+            m_details.append(Utils::breakLine(change.details, 250));
+            m_changed.append(false);
+            m_rows.insert(getBuild(m_projects.size() - 1), m_projects.size() - 1);
+        }
+        endInsertRows();
+    }
+}
+
+MonitorModel::Build MonitorModel::getBuild(int row) const
+{
+    Build build = {m_projects.at(row), m_packages.at(row), m_repositories.at(row), m_archs.at(row)};
+    return build;
+}
+
+void MonitorModel::updateRowIndex()
+{
+    m_rows.clear();
+    m_rows.reserve(m_projects.size());
+    for (int row = 0; row < m_projects.size(); row++) {
+        m_rows.insert(getBuild(row), row);
+    }
+}
+
+// The row index is left for the caller to update
+void MonitorModel::removeRowRange(int first, int count)
+{
+    beginRemoveRows(QModelIndex(), first, first + count - 1);
+    m_projects.remove(first, count);
+    m_packages.remove(first, count);
+    m_repositories.remove(first, count);
+    m_archs.remove(first, count);
+    m_statuses.remove(first, count);
+    m_details.remove(first, count);
+    m_changed.remove(first, count);
+    endRemoveRows();
+}
+
+// One dataChanged() per run of consecutive rows
+void MonitorModel::emitRowsChanged(const QList<int> &rows)
+{
+    QList<int> sortedRows = rows;
+    std::sort(sortedRows.begin(), sortedRows.end());
+    int i = 0;
+    while (i < sortedRows.size()) {
+        int first = sortedRows.at(i);
+        int last = first;
+        while (++i < sortedRows.size() && sortedRows.at(i) == last + 1) {
+            last++;
+        }
+        emit dataChanged(index(first, 0), index(last, ColumnCount - 1));
+    }
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MONITORMODEL_H
+#define MONITORMODEL_H
+
+#include <QAbstractTableModel>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QHash>
+#include <QVector>
+#include "obsresult.h"
+#include "obsstatus.h"
+#include "obsresultdiff.h"
+#include "obsstringpool.h"
+
+/*
+ * Builds (project, package, repository, arch) and their status, for
+ * the monitor tabs.
+ *
+ * Rows are kept column by column. Names are pooled once and rows only
+ * hold their ids, so a tab monitoring a big project costs a few ints
+ * per build instead of a QTreeWidgetItem. Result diffs are applied in
+ * place: only the rows whose status actually changed are updated.
+ * Changed rows are shown in bold until they are marked as read.
+ *
+ */
+class MonitorModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        ProjectColumn,
+        PackageColumn,
+        RepositoryColumn,
+        ArchColumn,
+        StatusColumn,
+        ColumnCount
+    };
+    explicit MonitorModel(QObject *parent = nullptr);
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+    bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
+
+    int addRow(const QString &project, const QString &package, const QString &repository, const QString &arch);
+    void setRow(int row, const QString &project, const QString &package, const QString &repository,
+                const QString &arch);
+    void clear();
+    int findRow(const QString &project, const QString &package, const QString &repository,
+                const QString &arch) const;
+    QString getProject(int row) const;
+    QString getPackage(int row) const;
+    QString getRepository(int row) const;
+    QString getArch(int row) const;
+    QString getStatus(int row) const;
+    bool isComplete(int row) const;
+    bool setStatus(int row, const QString &code, const QString &details);
+    void setChanged(int row, bool changed);
+    void markAllRead();
+    void applyResultDiff(const OBSResultDiff &diff);
+
+private:
+    struct Build {
+        int project;
+        int package;
+        int repository;
+        int arch;
+        bool operator==(const Build &other) const
+        {
+            return project == other.project && package == other.package
+                    && repository == other.repository && arch == other.arch;
+        }
+    };
+    friend size_t qHash(const Build &build, size_t seed)
+    {
+        return qHashMulti(seed, build.project, build.package, build.repository, build.arch);
+    }
+
+    OBSStringPool m_strings;
+    QVector<int> m_projects;
+    QVector<int> m_packages;
+    QVector<int> m_repositories;
+    QVector<int> m_archs;
+    QVector<int> m_statuses;
+    QVector<QString> m_details;
+    QVector<bool> m_changed;
+    QHash<Build, int> m_rows;
+    Build getBuild(int row) const;
+    void updateRowIndex();
+    void removeRowRange(int first, int count);
+    void emitRowsChanged(const QList<int> &rows);
+};
+
+#endif // MONITORMODEL_H
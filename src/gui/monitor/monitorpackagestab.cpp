@@ -16,18 +16,26 @@
 #include "monitorpackagestab.h"
 #include "ui_monitortab.h"
 
+// Keep the _result query string reasonably short for projects with many monitored packages
+static const int maxPackagesPerRequest = 50;
+
 MonitorPackagesTab::MonitorPackagesTab(QWidget *parent, const QString &title, OBS *obs) :
-    MonitorTab(parent, title, obs)
+    MonitorTab(parent, title, obs),
+    m_refreshToken(0)
 {
     setAcceptDrops(true);
 
     connect(this, &MonitorPackagesTab::obsUrlDropped, m_obs, &OBS::getPackageResults);
-    connect(m_obs, &OBS::finishedParsingResult, this, &MonitorPackagesTab::addDroppedPackage);
+    connect(m_obs, &OBS::finishedParsingResults, this, &MonitorPackagesTab::addDroppedPackage);
 
     connect(m_obs, &OBS::finishedParsingPackage, this, &MonitorPackagesTab::insertStatus);
-    connect(ui->treeWidget, &QTreeWidget::itemDoubleClicked, this, &MonitorPackagesTab::editRow);
+    connect(m_obs, &OBS::finishedParsingBuildResults, this, &MonitorPackagesTab::insertBuildResults);
+    connect(m_obs, &OBS::finishedParsingBuildResultList, this, &MonitorPackagesTab::onBuildResultsFinished);
+    connect(m_obs, &OBS::resultsChanged, this, &MonitorPackagesTab::onResultsChanged);
+    connect(ui->treeView, &QTreeView::doubleClicked, this, &MonitorPackagesTab::editRow);
     connect(m_obs, &OBS::finishedParsingResultList, this, &MonitorPackagesTab::onPackagesAdded);
-    connect(ui->treeWidget, &QTreeWidget::itemSelectionChanged, this, &MonitorPackagesTab::itemSelectionChanged);
+    connect(ui->treeView->selectionModel(), &QItemSelectionModel::selectionChanged,
+            this, &MonitorPackagesTab::itemSelectionChanged);
 
     readSettings();
 }
@@ -44,12 +52,8 @@ void MonitorPackagesTab::readSettings()
     for (int i=0; i<size; ++i)
     {
         settings.setArrayIndex(i);
-        QTreeWidgetItem *item = new QTreeWidgetItem(ui->treeWidget);
-        item->setText(0, settings.value("Project").toString());
-        item->setText(1, settings.value("Package").toString());
-        item->setText(2, settings.value("Repository").toString());
-        item->setText(3, settings.value("Arch").toString());
-        ui->treeWidget->insertTopLevelItem(i, item);
+        m_model->addRow(settings.value("Project").toString(), settings.value("Package").toString(),
+                        settings.value("Repository").toString(), settings.value("Arch").toString());
     }
     settings.endArray();
 }
@@ -57,21 +61,18 @@ void MonitorPackagesTab::readSettings()
 void MonitorPackagesTab::writeSettings()
 {
     QSettings settings;
-    int rows = ui->treeWidget->topLevelItemCount();
+    int rows = m_model->rowCount();
     settings.beginWriteArray("Monitor");
     settings.remove("");
     for (int i=0; i<rows; ++i) {
         settings.setArrayIndex(i);
 //        Save settings only if all the items in a row have text
-        if (!ui->treeWidget->topLevelItem(i)->text(0).isEmpty() &&
-                !ui->treeWidget->topLevelItem(i)->text(1).isEmpty() &&
-                !ui->treeWidget->topLevelItem(i)->text(2).isEmpty() &&
-                !ui->treeWidget->topLevelItem(i)->text(3).isEmpty())
+        if (m_model->isComplete(i))
         {
-            settings.setValue("Project", ui->treeWidget->topLevelItem(i)->text(0));
-            settings.setValue("Package", ui->treeWidget->topLevelItem(i)->text(1));
-            settings.setValue("Repository", ui->treeWidget->topLevelItem(i)->text(2));
-            settings.setValue("Arch", ui->treeWidget->topLevelItem(i)->text(3));
+            settings.setValue("Project", m_model->getProject(i));
+            settings.setValue("Package", m_model->getPackage(i));
+            settings.setValue("Repository", m_model->getRepository(i));
+            settings.setValue("Arch", m_model->getArch(i));
         }
     }
     settings.endArray();
@@ -80,30 +81,112 @@ void MonitorPackagesTab::writeSettings()
 void MonitorPackagesTab::refresh()
 {
     qDebug() << __PRETTY_FUNCTION__;
-        int rows = ui->treeWidget->topLevelItemCount();
+    QStringList projects;
+    QList<int> incompleteRows;
+    QHash<QString, QList<int>> rowsByProject = getRowsByProject(projects, incompleteRows);
+
+    foreach (int row, incompleteRows) {
+        getBuildStatus(row);
+    }
+
+//    One _result request per project (split in chunks of packages)
+//    instead of one _status request per row. The requests of the
+//    previous refresh are canceled and their replies ignored
+    m_obs->cancelRequests(m_refreshToken);
+    m_refreshToken = m_obs->createCancellationToken();
+    m_pendingRows.clear();
+    m_pendingRequests.clear();
+    m_obs->setCancellationToken(m_refreshToken);
+    foreach (const QString &project, projects) {
+        QStringList packages;
+        QStringList repositories;
+        QStringList archs;
+        getBuilds(rowsByProject.value(project), packages, repositories, archs);
+
+        m_pendingRows.insert(project, rowsByProject.value(project));
+        for (int i=0; i<packages.size(); i+=maxPackagesPerRequest) {
+            m_obs->getBuildResults(project, packages.mid(i, maxPackagesPerRequest), repositories, archs);
+            m_pendingRequests[project]++;
+        }
+        emit updateStatusBar(tr("Getting build results..."), false);
+    }
+    m_obs->setCancellationToken(0);
+
+    if (m_watchEnabled) {
+        watch();
+    }
+}
+
+void MonitorPackagesTab::watch()
+{
+    qDebug() << __PRETTY_FUNCTION__;
+    QStringList projects;
+    QList<int> incompleteRows;
+    QHash<QString, QList<int>> rowsByProject = getRowsByProject(projects, incompleteRows);
+    QStringList resources;
+
+    foreach (const QString &project, projects) {
+        QStringList packages;
+        QStringList repositories;
+        QStringList archs;
+        getBuilds(rowsByProject.value(project), packages, repositories, archs);
+
+        for (int i=0; i<packages.size(); i+=maxPackagesPerRequest) {
+            resources.append(m_obs->watchBuildResults(project, packages.mid(i, maxPackagesPerRequest),
+                                                      repositories, archs));
+        }
+    }
+    updateWatchedResources(resources);
+}
+
+QHash<QString, QList<int>> MonitorPackagesTab::getRowsByProject(QStringList &projects, QList<int> &incompleteRows) const
+{
+    QHash<QString, QList<int>> rowsByProject;
+    int rows = m_model->rowCount();
+
     for (int r=0; r<rows; r++) {
+        QString project = m_model->getProject(r);
 //        Ignore rows with empty cells and process rows with data
-        if (!ui->treeWidget->topLevelItem(r)->text(0).isEmpty() ||
-                !ui->treeWidget->topLevelItem(r)->text(1).isEmpty() ||
-                !ui->treeWidget->topLevelItem(r)->text(2).isEmpty() ||
-                !ui->treeWidget->topLevelItem(r)->text(3).isEmpty()) {
-            QStringList tableStringList;
-            tableStringList.append(QString(ui->treeWidget->topLevelItem(r)->text(0)));
-            tableStringList.append(QString(ui->treeWidget->topLevelItem(r)->text(2)));
-            tableStringList.append(QString(ui->treeWidget->topLevelItem(r)->text(3)));
-            tableStringList.append(QString(ui->treeWidget->topLevelItem(r)->text(1)));
-//            Get build status
-            m_obs->getBuildStatus(tableStringList, r);
-            emit updateStatusBar(tr("Getting build results..."), false);
+        if (project.isEmpty() && m_model->getPackage(r).isEmpty() &&
+                m_model->getRepository(r).isEmpty() && m_model->getArch(r).isEmpty()) {
+            continue;
+        }
+
+//        Incomplete rows can't be matched against a result list
+        if (!m_model->isComplete(r)) {
+            incompleteRows.append(r);
+            continue;
+        }
+
+        if (!rowsByProject.contains(project)) {
+            projects.append(project);
+        }
+        rowsByProject[project].append(r);
+    }
+    return rowsByProject;
+}
+
+void MonitorPackagesTab::getBuilds(const QList<int> &rows, QStringList &packages,
+                                   QStringList &repositories, QStringList &archs) const
+{
+    foreach (int row, rows) {
+        if (!packages.contains(m_model->getPackage(row))) {
+            packages.append(m_model->getPackage(row));
+        }
+        if (!repositories.contains(m_model->getRepository(row))) {
+            repositories.append(m_model->getRepository(row));
+        }
+        if (!archs.contains(m_model->getArch(row))) {
+            archs.append(m_model->getArch(row));
         }
     }
 }
 
 bool MonitorPackagesTab::hasSelection()
 {
-    QItemSelectionModel *treeWidgetSelectionModel = ui->treeWidget->selectionModel();
-    if (treeWidgetSelectionModel) {
-        return treeWidgetSelectionModel->hasSelection();
+    QItemSelectionModel *treeViewSelectionModel = ui->treeView->selectionModel();
+    if (treeViewSelectionModel) {
+        return treeViewSelectionModel->hasSelection();
     } else {
         return false;
     }
@@ -111,10 +194,9 @@ bool MonitorPackagesTab::hasSelection()
 
 bool MonitorPackagesTab::contains(const QString &project, const QString &package)
 {
-    int rows = ui->treeWidget->topLevelItemCount();
+    int rows = m_model->rowCount();
     for (int i = 0; i < rows; i++) {
-        if (ui->treeWidget->topLevelItem(i)->text(0) == project
-            && ui->treeWidget->topLevelItem(i)->text(1) == package) {
+        if (m_model->getProject(i) == project && m_model->getPackage(i) == package) {
             return true;
         }
     }
@@ -125,12 +207,7 @@ bool MonitorPackagesTab::contains(const QString &project, const QString &package
 void MonitorPackagesTab::addPackage(const QString &package, const QList<OBSResult> &builds)
 {
     foreach (auto build, builds) {
-        QTreeWidgetItem *item = new QTreeWidgetItem(ui->treeWidget);
-        item->setText(0, build.getProject());
-        item->setText(1, package);
-        item->setText(2, build.getRepository());
-        item->setText(3, build.getArch());
-        ui->treeWidget->addTopLevelItem(item);
+        m_model->addRow(build.getProject(), package, build.getRepository(), build.getArch());
     }
 }
 
@@ -165,30 +242,27 @@ void MonitorPackagesTab::dropEvent(QDropEvent *event)
     }
 }
 
-void MonitorPackagesTab::addDroppedPackage(QSharedPointer<OBSResult> result)
+void MonitorPackagesTab::addDroppedPackage(const OBSResultSet &resultSet)
 {
     qDebug() << Q_FUNC_INFO;
-
-    if (droppedProject==result->getProject() && droppedPackage==result->getStatus()->getPackage()) {
-        QTreeWidgetItem *item = new QTreeWidgetItem(ui->treeWidget);
-        item->setText(0, result->getProject());
-        item->setText(1, result->getStatus()->getPackage());
-        item->setText(2, result->getRepository());
-        item->setText(3, result->getArch());
-        QString status = result->getStatus()->getCode();
-        item->setText(4, status);
-        if (!result->getStatus()->getDetails().isEmpty()) {
-            QString details = result->getStatus()->getDetails();
+    bool added = false;
+
+    for (int i = 0; i < resultSet.size(); i++) {
+        OBSResultSet::Row result = resultSet.at(i);
+        if (droppedProject==result.getProject() && droppedPackage==result.getPackage()) {
+            int index = m_model->addRow(result.getProject(), result.getPackage(),
+                                        result.getRepository(), result.getArch());
+            QString details = result.getDetails();
             details = Utils::breakLine(details, 250);
-            item->setToolTip(4, details);
+            m_model->setStatus(index, result.getCode(), details);
+            qDebug() << Q_FUNC_INFO << "Package" << result.getPackage()
+                     << "(" << result.getProject() << "," << result.getRepository() << "," << result.getArch() << ")"
+                     << "added at" << index;
+            added = true;
         }
-        item->setForeground(4, Utils::getColorForStatus(status));
+    }
 
-        ui->treeWidget->addTopLevelItem(item);
-        int index = ui->treeWidget->indexOfTopLevelItem(item);
-        qDebug() << Q_FUNC_INFO << "Package" << item->text(1)
-                 << "(" << item->text(0) << "," << item->text(2) << "," << item->text(3) << ")"
-                 << "added at" << index;
+    if (added) {
         emit updateStatusBar(tr("Done"), true);
     }
 }
@@ -205,38 +279,138 @@ void MonitorPackagesTab::onPackagesAdded()
 void MonitorPackagesTab::insertStatus(QSharedPointer<OBSStatus> status, int row)
 {
     qDebug() << __PRETTY_FUNCTION__;
-    QString details = status->getDetails();
-    QString code = status->getCode();
+    if (row >= 0 && row < m_model->rowCount()) {
+        setRowStatus(row, status);
+        qDebug() << "Build status" << status->getCode() << "inserted in" << row
+                 << "(Total rows:" << m_model->rowCount() << ")";
 
-//    If the line is too long (>250), break it
-    details = Utils::breakLine(details, 250);
-    if (details.size()>0) {
-        qDebug() << "Details string size: " << details.size();
+        if (row == m_model->rowCount()-1) {
+            emit updateStatusBar(tr("Done"), true);
+        }
+    } else {
+        emit updateStatusBar(Utils::breakLine(status->getDetails(), 250), true);
     }
+}
 
-    QTreeWidgetItem *item = ui->treeWidget->topLevelItem(row);
-    if (item) {
-        QString oldCode = item->text(4);
-        item->setText(4, code);
-        if (!details.isEmpty()) {
-            item->setToolTip(4, details);
-        }
-        item->setForeground(4, Utils::getColorForStatus(code));
+void MonitorPackagesTab::insertBuildResults(const QString &project, const OBSResultSet &resultSet, int token)
+{
+    qDebug() << __PRETTY_FUNCTION__ << project;
+    if (token != m_refreshToken || !m_pendingRequests.contains(project)) {
+        return;
+    }
 
-        qDebug() << "Build status" << code << "inserted in" << row
-                 << "(Total rows:" << ui->treeWidget->topLevelItemCount() << ")";
+    setBuildResults(resultSet, m_pendingRows[project]);
+}
 
-        //    If the old status is not empty and it is different from latest one,
-        //    change the tray icon and enable the "Mark all as read" button
-        if (hasStatusChanged(oldCode, code)) {
-            Utils::setItemBoldFont(item, true);
+void MonitorPackagesTab::onBuildResultsFinished(const QString &project, int token)
+{
+    qDebug() << __PRETTY_FUNCTION__ << project;
+    if (token == m_refreshToken && m_pendingRequests.contains(project)) {
+        finishBuildResults(project);
+    }
+}
+
+void MonitorPackagesTab::onResultsChanged(const QString &resource, const OBSResultSet &resultSet)
+{
+    if (!m_watchedResources.contains(resource) || resultSet.isEmpty()) {
+        return;
+    }
+    qDebug() << __PRETTY_FUNCTION__ << resource;
+
+    QString project = resultSet.at(0).getProject();
+    QList<int> rows;
+    for (int r=0; r<m_model->rowCount(); r++) {
+        if (m_model->getProject(r) == project) {
+            rows.append(r);
         }
+    }
+    setBuildResults(resultSet, rows);
+}
 
-        if (row == ui->treeWidget->topLevelItemCount()-1) {
-            emit updateStatusBar(tr("Done"), true);
+void MonitorPackagesTab::setBuildResults(const OBSResultSet &resultSet, QList<int> &rows)
+{
+    // repository/arch/package -> index in the result set
+    QHash<QString, int> statuses;
+    statuses.reserve(resultSet.size());
+    for (int i = 0; i < resultSet.size(); i++) {
+        OBSResultSet::Row result = resultSet.at(i);
+        QString key = result.getRepository() + "/" + result.getArch() + "/" + result.getPackage();
+        statuses.insert(key, i);
+    }
+
+//    Matched rows are removed from the list
+    for (int i=rows.size()-1; i>=0; i--) {
+        int row = rows.at(i);
+        if (row >= m_model->rowCount()) {
+            rows.removeAt(i);
+            continue;
         }
-    } else {
-        emit updateStatusBar(details, true);
+        QString key = m_model->getRepository(row) + "/" + m_model->getArch(row) + "/" + m_model->getPackage(row);
+        auto it = statuses.constFind(key);
+        if (it != statuses.constEnd() && resultSet.at(it.value()).getProject() == m_model->getProject(row)) {
+            OBSResultSet::Row result = resultSet.at(it.value());
+            setRowStatus(row, result.getCode(), result.getDetails());
+            rows.removeAt(i);
+        }
+    }
+}
+
+void MonitorPackagesTab::finishBuildResults(const QString &project)
+{
+    if (--m_pendingRequests[project] > 0) {
+        return;
+    }
+
+//    Rows missing from the result list (i.e. package not found) get
+//    their own _status request, which reports the reason
+    foreach (int row, m_pendingRows.value(project)) {
+        getBuildStatus(row);
+    }
+    m_pendingRows.remove(project);
+    m_pendingRequests.remove(project);
+
+    if (m_pendingRequests.isEmpty()) {
+        emit updateStatusBar(tr("Done"), true);
+    }
+}
+
+void MonitorPackagesTab::getBuildStatus(int row)
+{
+    if (row >= m_model->rowCount()) {
+        return;
+    }
+    QStringList tableStringList;
+    tableStringList.append(m_model->getProject(row));
+    tableStringList.append(m_model->getRepository(row));
+    tableStringList.append(m_model->getArch(row));
+    tableStringList.append(m_model->getPackage(row));
+//    Get build status
+    m_obs->getBuildStatus(tableStringList, row);
+    emit updateStatusBar(tr("Getting build results..."), false);
+}
+
+void MonitorPackagesTab::setRowStatus(int row, QSharedPointer<OBSStatus> status)
+{
+    setRowStatus(row, status->getCode(), status->getDetails());
+}
+
+void MonitorPackagesTab::setRowStatus(int row, const QString &code, const QString &details)
+{
+//    If the line is too long (>250), break it
+    QString brokenDetails = Utils::breakLine(details, 250);
+    if (brokenDetails.size()>0) {
+        qDebug() << "Details string size: " << brokenDetails.size();
+    }
+
+    QString oldCode = m_model->getStatus(row);
+    if (!m_model->setStatus(row, code, brokenDetails)) {
+        return;
+    }
+
+    //    If the old status is not empty and it is different from latest one,
+    //    change the tray icon and enable the "Mark all as read" button
+    if (hasStatusChanged(oldCode, code)) {
+        m_model->setChanged(row, true);
     }
 }
 
@@ -246,70 +420,42 @@ void MonitorPackagesTab::addRow()
     RowEditor rowEditor(this, m_obs);
 
     if (rowEditor.exec()) {
-        QTreeWidgetItem *item = new QTreeWidgetItem(ui->treeWidget);
-        item->setText(0, rowEditor.getProject());
-        item->setText(1, rowEditor.getPackage());
-        item->setText(2, rowEditor.getRepository());
-        item->setText(3, rowEditor.getArch());
-        ui->treeWidget->addTopLevelItem(item);
-        int index = ui->treeWidget->indexOfTopLevelItem(item);
-        qDebug() << Q_FUNC_INFO << "Build" << item->text(1) << "added at" << index;
+        int index = m_model->addRow(rowEditor.getProject(), rowEditor.getPackage(),
+                                    rowEditor.getRepository(), rowEditor.getArch());
+        qDebug() << Q_FUNC_INFO << "Build" << rowEditor.getPackage() << "added at" << index;
     }
 }
 
 void MonitorPackagesTab::removeRow()
 {
     qDebug () << Q_FUNC_INFO;
-    QList<QTreeWidgetItem *> items = ui->treeWidget->selectedItems();
-    QList<QModelIndex> list = ui->treeWidget->selectionModel()->selectedIndexes();
-    foreach (QTreeWidgetItem *item, items) {
-        delete item;
+    foreach (int row, getSelectedRows()) {
+        m_model->removeRows(row, 1);
     }
 
-    if (!list.isEmpty()) {
-        QTreeWidgetItem *curItem = ui->treeWidget->currentItem();
-        if (curItem) {
-            curItem->setSelected(true);
-        }
+    QModelIndex currentIndex = ui->treeView->currentIndex();
+    if (currentIndex.isValid()) {
+        ui->treeView->selectionModel()->select(currentIndex,
+                                               QItemSelectionModel::Select | QItemSelectionModel::Rows);
     }
 }
 
-void MonitorPackagesTab::editRow(QTreeWidgetItem *item, int column)
+void MonitorPackagesTab::editRow(const QModelIndex &index)
 {
-    Q_UNUSED(column)
+    int row = m_proxyModel->mapToSource(index).row();
 
     qDebug() << Q_FUNC_INFO;
     RowEditor rowEditor(this, m_obs);
-    rowEditor.setProject(item->text(0));
-    rowEditor.setPackage(item->text(1));
-    rowEditor.setRepository(item->text(2));
-    rowEditor.setArch(item->text(3));
+    rowEditor.setProject(m_model->getProject(row));
+    rowEditor.setPackage(m_model->getPackage(row));
+    rowEditor.setRepository(m_model->getRepository(row));
+    rowEditor.setArch(m_model->getArch(row));
     rowEditor.show();
 
     if (rowEditor.exec()) {
-        int index = ui->treeWidget->indexOfTopLevelItem(item);
-        item->setText(0, rowEditor.getProject());
-        item->setText(1, rowEditor.getPackage());
-        item->setText(2, rowEditor.getRepository());
-        item->setText(3, rowEditor.getArch());
-        item->setText(4, "");
-        ui->treeWidget->insertTopLevelItem(index, item);
-        qDebug() << Q_FUNC_INFO << "Build edited:" << index;
-        qDebug() << Q_FUNC_INFO << "Status at" << index << item->text(4) << "(it should be empty)";
+        m_model->setRow(row, rowEditor.getProject(), rowEditor.getPackage(),
+                        rowEditor.getRepository(), rowEditor.getArch());
+        qDebug() << Q_FUNC_INFO << "Build edited:" << row;
+        qDebug() << Q_FUNC_INFO << "Status at" << row << m_model->getStatus(row) << "(it should be empty)";
     }
 }
-
-void MonitorPackagesTab::slotMarkRead(QTreeWidgetItem *item, int column)
-{
-    Q_UNUSED(column)
-
-    qDebug() << __PRETTY_FUNCTION__ << "Row: " + QString::number(ui->treeWidget->indexOfTopLevelItem(item));
-    for (int i=0; i<ui->treeWidget->columnCount(); i++) {
-        if (item->font(0).bold()) {
-            Utils::setItemBoldFont(item, false);
-        }
-    }
-
-    emit notifyChanged(false);
-}
-
@@ -17,12 +17,12 @@
 #define MONITORPACKAGESTAB_H
 
 #include <QObject>
-#include <QTreeWidget>
-#include <QTreeWidgetItem>
 #include <QDebug>
 #include <QSharedPointer>
+#include <QHash>
 #include "obs.h"
 #include "obsresult.h"
+#include "obsresultset.h"
 #include "monitortab.h"
 
 class MonitorPackagesTab : public MonitorTab
@@ -33,6 +33,7 @@ public:
     explicit MonitorPackagesTab(QWidget *parent = nullptr, const QString &title = "untitled", OBS *obs = nullptr);
     virtual ~MonitorPackagesTab();
     void refresh();
+    void watch();
     bool hasSelection();
     bool contains(const QString &project, const QString &package);
     void addPackage(const QString &package, const QList<OBSResult> &builds);
@@ -44,9 +45,12 @@ signals:
     void itemSelectionChanged();
 
 public slots:
-    void addDroppedPackage(QSharedPointer<OBSResult> result);
+    void addDroppedPackage(const OBSResultSet &resultSet);
     void onPackagesAdded();
     void insertStatus(QSharedPointer<OBSStatus> status, int row);
+    void insertBuildResults(const QString &project, const OBSResultSet &resultSet, int token);
+    void onBuildResultsFinished(const QString &project, int token);
+    void onResultsChanged(const QString &resource, const OBSResultSet &resultSet);
     void addRow();
     void removeRow();
 
@@ -58,10 +62,19 @@ private:
     QString droppedPackage;
     void readSettings();
     void writeSettings();
+    QHash<QString, QList<int>> m_pendingRows;
+    QHash<QString, int> m_pendingRequests;
+    int m_refreshToken;
+    QHash<QString, QList<int>> getRowsByProject(QStringList &projects, QList<int> &incompleteRows) const;
+    void getBuilds(const QList<int> &rows, QStringList &packages, QStringList &repositories, QStringList &archs) const;
+    void setBuildResults(const OBSResultSet &resultSet, QList<int> &rows);
+    void setRowStatus(int row, QSharedPointer<OBSStatus> status);
+    void setRowStatus(int row, const QString &code, const QString &details);
+    void getBuildStatus(int row);
+    void finishBuildResults(const QString &project);
 
 private slots:
-    void editRow(QTreeWidgetItem *item, int column);
-    void slotMarkRead(QTreeWidgetItem *item, int column);
+    void editRow(const QModelIndex &index);
 
 };
 
@@ -19,7 +19,9 @@
 MonitorRepositoryTab::MonitorRepositoryTab(QWidget *parent, const QString &title, OBS *obs) :
     MonitorTab(parent, title, obs)
 {
-    connect(m_obs, &OBS::finishedParsingResultList, this, &MonitorRepositoryTab::addResultList);
+    // Partial lists (e.g. of a package) would remove the other builds
+    connect(m_obs, &OBS::finishedParsingProjectResultList, this, &MonitorRepositoryTab::addResultList);
+    connect(m_obs, &OBS::resultsChanged, this, &MonitorRepositoryTab::onResultsChanged);
 }
 
 MonitorRepositoryTab::~MonitorRepositoryTab()
@@ -33,98 +35,51 @@ void MonitorRepositoryTab::refresh()
     qDebug() << Q_FUNC_INFO;
     m_obs->getProjectResults(m_title);
     emit updateStatusBar(tr("Getting build statuses..."), false);
+
+    if (m_watchEnabled) {
+        watch();
+    }
 }
 
 bool MonitorRepositoryTab::hasSelection()
 {
-    QItemSelectionModel *treeWidgetSelectionModel = ui->treeWidget->selectionModel();
-    if (treeWidgetSelectionModel) {
-        return treeWidgetSelectionModel->hasSelection();
+    QItemSelectionModel *treeViewSelectionModel = ui->treeView->selectionModel();
+    if (treeViewSelectionModel) {
+        return treeViewSelectionModel->hasSelection();
     } else {
         return false;
     }
 }
 
-void MonitorRepositoryTab::addResultList(QList<QSharedPointer<OBSResult>> resultList)
+void MonitorRepositoryTab::addResultList(const QString &project, const OBSResultSet &resultSet)
 {
     qDebug() << __PRETTY_FUNCTION__;
 
-    if (!resultList.isEmpty() && m_title == resultList.first()->getProject()) {
-
-        if (ui->treeWidget->topLevelItemCount() > 0) {
-            checkForResultListChanges(resultList);
-            ui->treeWidget->clear();
-        }
-
-        m_resultList = resultList;
-        QTreeWidgetItem *item = nullptr;
-
-        for (QSharedPointer<OBSResult> result : resultList) {
-            for (QSharedPointer<OBSStatus> status : result->getStatusList()) {
-
-                item = new QTreeWidgetItem(ui->treeWidget);
-                item->setText(0, result->getProject());
-                item->setText(1, status->getPackage());
-                item->setText(2, result->getRepository());
-                item->setText(3, result->getArch());
-                item->setText(4, status->getCode());
-
-                if (!status->getDetails().isEmpty()) {
-                    QString details = status->getDetails();
-                    details = Utils::breakLine(details, 250);
-                    item->setToolTip(4, details);
-                }
-                item->setForeground(4, Utils::getColorForStatus(status->getCode()));
+    if (project != m_title) {
+        return;
+    }
 
-                ui->treeWidget->addTopLevelItem(item);
+    if (!resultSet.isEmpty()) {
+//        Only the builds which changed since the last result list are updated
+        m_resultDiff.update(resultSet);
+        m_model->applyResultDiff(m_resultDiff);
+
+//        Changed builds are shown in bold and notified (tray icon)
+        foreach (const OBSResultDiff::Change &change, m_resultDiff.getChanged()) {
+            if (hasStatusChanged(change.oldCode, change.code)) {
+                const OBSResultDiff::Build &build = change.build;
+                m_model->setChanged(m_model->findRow(build.project, build.package, build.repository, build.arch),
+                                    true);
             }
         }
     }
     emit updateStatusBar(tr("Done"), true);
 }
 
-void MonitorRepositoryTab::checkForResultListChanges(QList<QSharedPointer<OBSResult>> resultList)
+void MonitorRepositoryTab::onResultsChanged(const QString &resource, const OBSResultSet &resultSet)
 {
-    // FIXME: intersect always returns 0
-    QSet<QSharedPointer<OBSResult>> old_resultSet(m_resultList.begin(), m_resultList.end());
-    QSet<QSharedPointer<OBSResult>> new_resultSet(resultList.begin(), resultList.end());
-
-    QList<QSharedPointer<OBSResult>> commonResults = old_resultSet.intersect(new_resultSet).values();
-
-    for (QSharedPointer<OBSResult> oldResult : commonResults) {
-        for (QSharedPointer<OBSResult> newResult : resultList) {
-
-            if (oldResult == newResult) {
-
-                for (QSharedPointer<OBSStatus> oldStatus : oldResult->getStatusList()) {
-                    for (QSharedPointer<OBSStatus> newStatus : newResult->getStatusList()) {
-
-                        if (oldStatus == newStatus
-                                && hasStatusChanged(oldStatus->getCode(), newStatus->getCode())) {
-
-                            // get row index
-                            int resultIndex = resultList.indexOf(newResult);
-                            int statusIndex = newResult->getStatusList().indexOf(newStatus);
-
-                            if (resultIndex != 0) {
-                                int count = 0;
-                                for (int i=resultIndex; i<resultList.count(); i++) {
-                                    count += resultList.at(i)->getStatusList().count();
-                                }
-                                statusIndex += count;
-                            }
-
-                            QTreeWidgetItem *item = ui->treeWidget->topLevelItem(statusIndex);
-                            Utils::setItemBoldFont(item, true);
-                            break;
-                        }
-                    }
-                }
-
-                break;
-            }
-        }
+    if (m_watchedResources.contains(resource)) {
+        qDebug() << __PRETTY_FUNCTION__ << resource;
+        addResultList(m_title, resultSet);
     }
 }
-
-
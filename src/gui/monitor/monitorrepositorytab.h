@@ -17,13 +17,12 @@
 #define MONITORREPOSITORYTAB_H
 
 #include <QObject>
-#include <QTreeWidget>
-#include <QTreeWidgetItem>
 #include <QSharedPointer>
 #include "obs.h"
-#include "obsresult.h"
+#include "obsresultset.h"
 #include <QDebug>
 #include "monitortab.h"
+#include "obsresultdiff.h"
 
 class MonitorRepositoryTab : public MonitorTab
 {
@@ -40,11 +39,11 @@ signals:
     void notifyChanged(bool change);
 
 public slots:
-    void addResultList(QList<QSharedPointer<OBSResult>> resultList);
+    void addResultList(const QString &project, const OBSResultSet &resultSet);
+    void onResultsChanged(const QString &resource, const OBSResultSet &resultSet);
 
 private:
-    void checkForResultListChanges(QList<QSharedPointer<OBSResult>> resultList);
-    QList<QSharedPointer<OBSResult>> m_resultList;
+    OBSResultDiff m_resultDiff;
 
 };
 
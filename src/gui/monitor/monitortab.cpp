@@ -15,26 +15,33 @@
  */
 #include "monitortab.h"
 #include "ui_monitortab.h"
+#include <algorithm>
+#include <functional>
 
 MonitorTab::MonitorTab(QWidget *parent, const QString &title, OBS *obs) :
     QWidget(parent),
     ui(new Ui::MonitorTab),
     m_title(title),
-    m_obs(obs)
+    m_obs(obs),
+    m_watchEnabled(false),
+    m_model(new MonitorModel(this)),
+    m_proxyModel(new QSortFilterProxyModel(this))
 {
     ui->setupUi(this);
 
-    ui->treeWidget->setColumnCount(5);
-    ui->treeWidget->setColumnWidth(0, 200); // Project
-    ui->treeWidget->setColumnWidth(1, 200); // Package
-    ui->treeWidget->setColumnWidth(2, 210); // Repository
-    ui->treeWidget->setColumnWidth(3, 75); // Arch
-    ui->treeWidget->setColumnWidth(4, 100); // Status
+    m_proxyModel->setSourceModel(m_model);
+    ui->treeView->setModel(m_proxyModel);
+    ui->treeView->setColumnWidth(MonitorModel::ProjectColumn, 200);
+    ui->treeView->setColumnWidth(MonitorModel::PackageColumn, 200);
+    ui->treeView->setColumnWidth(MonitorModel::RepositoryColumn, 210);
+    ui->treeView->setColumnWidth(MonitorModel::ArchColumn, 75);
+    ui->treeView->setColumnWidth(MonitorModel::StatusColumn, 100);
 
-    ui->treeWidget->setItemDelegate(new AutoToolTipDelegate(this));
+    ui->treeView->setItemDelegate(new AutoToolTipDelegate(this));
 
-    connect(ui->treeWidget, &QTreeWidget::itemClicked, this, &MonitorTab::slotMarkRead);
-    connect(ui->treeWidget, &QTreeWidget::itemSelectionChanged, this, &MonitorTab::itemSelectionChanged);
+    connect(ui->treeView, &QTreeView::clicked, this, &MonitorTab::slotMarkRead);
+    connect(ui->treeView->selectionModel(), &QItemSelectionModel::selectionChanged,
+            this, &MonitorTab::itemSelectionChanged);
 }
 
 MonitorTab::~MonitorTab()
@@ -48,24 +55,59 @@ void MonitorTab::refresh()
     m_obs->getProjectResults(m_title);
 }
 
+void MonitorTab::setWatchEnabled(bool enabled)
+{
+    qDebug() << __PRETTY_FUNCTION__ << m_title << enabled;
+    m_watchEnabled = enabled;
+    if (!enabled) {
+        updateWatchedResources(QStringList());
+    } else if (m_obs->isAuthenticated()) {
+        watch();
+    }
+}
+
+void MonitorTab::watch()
+{
+    updateWatchedResources(QStringList() << m_obs->watchProjectResults(m_title));
+}
+
+void MonitorTab::updateWatchedResources(const QStringList &resources)
+{
+//    Watches are counted per resource and the new ones are already set,
+//    so releasing the previous ones keeps those (and their last state)
+//    which are still needed
+    foreach (const QString &resource, m_watchedResources) {
+        m_obs->unwatchResults(resource);
+    }
+    m_watchedResources = resources;
+}
+
 bool MonitorTab::hasSelection()
 {
-    QItemSelectionModel *treeWidgetSelectionModel = ui->treeWidget->selectionModel();
-    if (treeWidgetSelectionModel) {
-        return treeWidgetSelectionModel->hasSelection();
+    QItemSelectionModel *treeViewSelectionModel = ui->treeView->selectionModel();
+    if (treeViewSelectionModel) {
+        return treeViewSelectionModel->hasSelection();
     } else {
         return false;
     }
 }
 
+// Selected rows of m_model, last first
+QList<int> MonitorTab::getSelectedRows() const
+{
+    QList<int> rows;
+    const QModelIndexList indexes = ui->treeView->selectionModel()->selectedRows();
+    for (const QModelIndex &index : indexes) {
+        rows.append(m_proxyModel->mapToSource(index).row());
+    }
+    std::sort(rows.begin(), rows.end(), std::greater<int>());
+    return rows;
+}
+
 void MonitorTab::slotMarkAllRead()
 {
     qDebug() << __PRETTY_FUNCTION__;
-    for (int i=0; i<ui->treeWidget->topLevelItemCount(); i++) {
-        if (ui->treeWidget->topLevelItem(i)->font(0).bold()) {
-            Utils::setItemBoldFont(ui->treeWidget->topLevelItem(i), false);
-        }
-    }
+    m_model->markAllRead();
 
     emit notifyChanged(false);
 }
@@ -83,16 +125,11 @@ bool MonitorTab::hasStatusChanged(const QString &oldStatus, const QString &newSt
     return change;
 }
 
-void MonitorTab::slotMarkRead(QTreeWidgetItem *item, int column)
+void MonitorTab::slotMarkRead(const QModelIndex &index)
 {
-    Q_UNUSED(column)
-
-    qDebug() << __PRETTY_FUNCTION__ << "Row: " + QString::number(ui->treeWidget->indexOfTopLevelItem(item));
-    for (int i=0; i<ui->treeWidget->columnCount(); i++) {
-        if (item->font(0).bold()) {
-            Utils::setItemBoldFont(item, false);
-        }
-    }
+    int row = m_proxyModel->mapToSource(index).row();
+    qDebug() << __PRETTY_FUNCTION__ << "Row: " + QString::number(row);
+    m_model->setChanged(row, false);
 
     emit notifyChanged(false);
 }
@@ -17,16 +17,17 @@
 #define MONITORTAB_H
 
 #include <QObject>
-#include <QTreeWidget>
+#include <QTreeView>
+#include <QSortFilterProxyModel>
 #include <QDropEvent>
 #include <QMimeData>
-#include <QTreeWidgetItem>
 #include "obs.h"
 #include "obsresult.h"
 #include <QDebug>
 #include "utils.h"
 #include "autotooltipdelegate.h"
 #include "roweditor.h"
+#include "monitormodel.h"
 
 namespace Ui {
 class MonitorTab;
@@ -41,15 +42,23 @@ public:
     virtual ~MonitorTab();
     virtual void refresh();
     virtual bool hasSelection();
+    void setWatchEnabled(bool enabled);
+    virtual void watch();
 
 protected:
     bool hasStatusChanged(const QString &oldStatus, const QString &newStatus);
+    void updateWatchedResources(const QStringList &resources);
     void dragEnterEvent(QDragEnterEvent *event);
     void dragMoveEvent(QDragMoveEvent *event);
     void dropEvent(QDropEvent *event);
+    QList<int> getSelectedRows() const;
     Ui::MonitorTab *ui;
+    MonitorModel *m_model;
+    QSortFilterProxyModel *m_proxyModel;
     QString m_title;
     OBS *m_obs;
+    bool m_watchEnabled;
+    QStringList m_watchedResources;
 
 signals:
     void updateStatusBar(QString message, bool progressBarHidden);
@@ -60,7 +69,7 @@ public slots:
     void slotMarkAllRead();
 
 private slots:
-    void slotMarkRead(QTreeWidgetItem *item, int column);
+    void slotMarkRead(const QModelIndex &index);
 
 };
 
@@ -41,11 +41,11 @@ RequestBox::RequestBox(QWidget *parent, OBS *obs) :
     connect(ui->treeRequestBoxes, &RequestBoxTreeWidget::getOutgoingRequests, this, &RequestBox::getOutgoingRequests);
     connect(ui->treeRequestBoxes, &RequestBoxTreeWidget::getDeclinedRequests, this, &RequestBox::getDeclinedRequests);
 
-    connect(m_obs, &OBS::finishedParsingIncomingRequest, this, &RequestBox::addIncomingRequest);
+    connect(m_obs, &OBS::finishedParsingIncomingRequests, this, &RequestBox::addIncomingRequests);
     connect(m_obs, &OBS::finishedParsingIncomingRequestList, this, &RequestBox::incomingRequestsFetched);
-    connect(m_obs, &OBS::finishedParsingOutgoingRequest, this, &RequestBox::addOutgoingRequest);
+    connect(m_obs, &OBS::finishedParsingOutgoingRequests, this, &RequestBox::addOutgoingRequests);
     connect(m_obs, &OBS::finishedParsingOutgoingRequestList, this, &RequestBox::outgoingRequestsFetched);
-    connect(m_obs, &OBS::finishedParsingDeclinedRequest, this, &RequestBox::addDeclinedRequest);
+    connect(m_obs, &OBS::finishedParsingDeclinedRequests, this, &RequestBox::addDeclinedRequests);
     connect(m_obs, &OBS::finishedParsingDeclinedRequestList, this, &RequestBox::outgoingRequestsFetched);
     connect(m_obs, &OBS::finishedParsingRequestStatus, this, &RequestBox::onStatusFetched);
 
@@ -79,10 +79,10 @@ void RequestBox::writeSettings()
     settings.endGroup();
 }
 
-void RequestBox::addIncomingRequest(QSharedPointer<OBSRequest> request)
+void RequestBox::addIncomingRequests(QList<QSharedPointer<OBSRequest>> requestList)
 {
-    qDebug() << Q_FUNC_INFO;
-    incomingRequestsModel->appendRequest(request);
+    qDebug() << Q_FUNC_INFO << requestList.size();
+    incomingRequestsModel->appendRequests(requestList);
 }
 
 void RequestBox::incomingRequestsFetched()
@@ -91,10 +91,10 @@ void RequestBox::incomingRequestsFetched()
     emit updateStatusBar(tr("Done"), true);
 }
 
-void RequestBox::addOutgoingRequest(QSharedPointer<OBSRequest> request)
+void RequestBox::addOutgoingRequests(QList<QSharedPointer<OBSRequest>> requestList)
 {
-    qDebug() << Q_FUNC_INFO;
-    outgoingRequestsModel->appendRequest(request);
+    qDebug() << Q_FUNC_INFO << requestList.size();
+    outgoingRequestsModel->appendRequests(requestList);
 }
 
 void RequestBox::outgoingRequestsFetched()
@@ -103,10 +103,10 @@ void RequestBox::outgoingRequestsFetched()
     emit updateStatusBar(tr("Done"), true);
 }
 
-void RequestBox::addDeclinedRequest(QSharedPointer<OBSRequest> request)
+void RequestBox::addDeclinedRequests(QList<QSharedPointer<OBSRequest>> requestList)
 {
-    qDebug() << Q_FUNC_INFO;
-    declinedRequestsModel->appendRequest(request);
+    qDebug() << Q_FUNC_INFO << requestList.size();
+    declinedRequestsModel->appendRequests(requestList);
 }
 
 void RequestBox::declinedRequestsFetched()
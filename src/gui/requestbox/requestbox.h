@@ -51,11 +51,11 @@ signals:
     void descriptionFetched(const QString &description);
 
 public slots:
-    void addIncomingRequest(QSharedPointer<OBSRequest> request);
+    void addIncomingRequests(QList<QSharedPointer<OBSRequest>> requestList);
     void incomingRequestsFetched();
-    void addOutgoingRequest(QSharedPointer<OBSRequest> request);
+    void addOutgoingRequests(QList<QSharedPointer<OBSRequest>> requestList);
     void outgoingRequestsFetched();
-    void addDeclinedRequest(QSharedPointer<OBSRequest> request);
+    void addDeclinedRequests(QList<QSharedPointer<OBSRequest>> requestList);
     void declinedRequestsFetched();
     bool removeIncomingRequest(const QString &id);
     bool removeOutgoingRequest(const QString &id);
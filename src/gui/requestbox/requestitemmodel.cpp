@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "requestitemmodel.h"
+#include "utils.h"
 
 RequestItemModel::RequestItemModel(QObject *parent) :
     QStandardItemModel (parent)
@@ -23,14 +24,21 @@ RequestItemModel::RequestItemModel(QObject *parent) :
     setHorizontalHeaderLabels(headerLabels);
 }
 
-void RequestItemModel::appendRequest(QSharedPointer<OBSRequest> request)
+void RequestItemModel::appendRequests(QList<QSharedPointer<OBSRequest>> requestList)
 {
-    QString id = request->getId();
+    QSet<QString> ids(idList.begin(), idList.end());
+    QList<QList<QStandardItem *>> rows;
 
-    if (!id.isEmpty() && !idList.contains(id)) {
-        appendRow(requestToItems(request));
-        idList.append(request->getId());
+    foreach (QSharedPointer<OBSRequest> request, requestList) {
+        QString id = request->getId();
+
+        if (!id.isEmpty() && !ids.contains(id)) {
+            rows.append(requestToItems(request));
+            idList.append(id);
+            ids.insert(id);
+        }
     }
+    Utils::appendRows(this, rows);
 }
 
 QString RequestItemModel::getDescription(const QModelIndex &index) const
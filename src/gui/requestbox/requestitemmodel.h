@@ -29,7 +29,7 @@ class RequestItemModel : public QStandardItemModel
 public:
     RequestItemModel(QObject *parent = nullptr);
 
-    void appendRequest(QSharedPointer<OBSRequest> request);
+    void appendRequests(QList<QSharedPointer<OBSRequest>> requestList);
     QString getDescription(const QModelIndex &index) const;
     QSharedPointer<OBSRequest> getRequest(const QModelIndex &index);
     bool removeRequest(const QString &id);
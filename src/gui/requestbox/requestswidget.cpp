@@ -89,9 +89,9 @@ void RequestsWidget::writeSettings()
     settings.endGroup();
 }
 
-void RequestsWidget::addRequest(QSharedPointer<OBSRequest> request)
+void RequestsWidget::addRequests(QList<QSharedPointer<OBSRequest>> requestList)
 {
-    itemModel->appendRequest(request);
+    itemModel->appendRequests(requestList);
 }
 
 void RequestsWidget::requestsAdded(const QString &project, const QString &package)
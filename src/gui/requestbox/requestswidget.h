@@ -58,7 +58,7 @@ signals:
     void descriptionFetched(const QString &description);
 
 public slots:
-    void addRequest(QSharedPointer<OBSRequest> request);
+    void addRequests(QList<QSharedPointer<OBSRequest>> requestList);
     void requestsAdded(const QString &project, const QString &package);
 
 private slots:
@@ -41,7 +41,7 @@ RequestViewer::RequestViewer(QWidget *parent, OBS *obs, QSharedPointer<OBSReques
     connect(this, &RequestViewer::changeRequest, m_obs, &OBS::onChangeRequest);
     connect(m_obs, &OBS::finishedParsingRequestStatus, this, &RequestViewer::slotRequestStatusFetched);
     connect(m_obs, &OBS::requestDiffFetched, this, &RequestViewer::onRequestDiffFetched);
-    connect(m_obs, &OBS::finishedParsingResult, this, &RequestViewer::slotAddBuildResults);
+    connect(m_obs, &OBS::finishedParsingResults, this, &RequestViewer::slotAddBuildResults);
 
     if (m_request->getActionType()=="submit") {
         // Get SR diff
@@ -127,22 +127,30 @@ void RequestViewer::onRequestDiffFetched(const QString &diff)
     setDiff(diff);
 }
 
-void RequestViewer::slotAddBuildResults(QSharedPointer<OBSResult> result)
+void RequestViewer::slotAddBuildResults(const OBSResultSet &resultSet)
 {
     QStandardItemModel *model = static_cast<QStandardItemModel*>(ui->treeBuildResults->model());
     if (model) {
-        QStandardItem *itemRepository = new QStandardItem(result->getRepository());
-        QStandardItem *itemArch = new QStandardItem(result->getArch());
-        QStandardItem *itemBuildResult = new QStandardItem(result->getStatus()->getCode());
-        itemBuildResult->setForeground(Utils::getColorForStatus(itemBuildResult->text()));
-
-        if (!result->getStatus()->getDetails().isEmpty()) {
-            QString details = result->getStatus()->getDetails();
-            details = Utils::breakLine(details, 250);
-            itemBuildResult->setToolTip(details);
+        QList<QList<QStandardItem *>> rows;
+        for (int i = 0; i < resultSet.size(); i++) {
+            OBSResultSet::Row result = resultSet.at(i);
+            if (result.getProject() != m_request->getSourceProject()
+                    || result.getPackage() != m_request->getSourcePackage()) {
+                continue;
+            }
+            QStandardItem *itemRepository = new QStandardItem(result.getRepository());
+            QStandardItem *itemArch = new QStandardItem(result.getArch());
+            QStandardItem *itemBuildResult = new QStandardItem(result.getCode());
+            itemBuildResult->setForeground(Utils::getColorForStatus(itemBuildResult->text()));
+
+            QString details = result.getDetails();
+            if (!details.isEmpty()) {
+                details = Utils::breakLine(details, 250);
+                itemBuildResult->setToolTip(details);
+            }
+
+            rows.append({itemRepository, itemArch, itemBuildResult});
         }
-
-        QList<QStandardItem *> items = {itemRepository, itemArch, itemBuildResult};
-        model->appendRow(items);
+        Utils::appendRows(model, rows);
     }
 }
@@ -51,7 +51,7 @@ private slots:
     void on_declinePushButton_clicked();
     void slotRequestStatusFetched(QSharedPointer<OBSStatus> status);
     void onRequestDiffFetched(const QString &diff);
-    void slotAddBuildResults(QSharedPointer<OBSResult> result);
+    void slotAddBuildResults(const OBSResultSet &resultSet);
 
 private:
     Ui::RequestViewer *ui;
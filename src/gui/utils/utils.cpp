@@ -106,3 +106,21 @@ void Utils::setItemBoldFont(QTreeWidgetItem *item, bool bold)
         item->setFont(i, font);
     }
 }
+
+// QStandardItemModel::appendRow() notifies the views of each row, so the
+// rows are inserted at once and then filled in
+void Utils::appendRows(QStandardItemModel *model, const QList<QList<QStandardItem *>> &rows)
+{
+    if (rows.isEmpty()) {
+        return;
+    }
+
+    int first = model->rowCount();
+    model->insertRows(first, rows.size());
+    for (int i = 0; i < rows.size(); i++) {
+        const QList<QStandardItem *> &items = rows.at(i);
+        for (int column = 0; column < items.size(); column++) {
+            model->setItem(first + i, column, items.at(column));
+        }
+    }
+}
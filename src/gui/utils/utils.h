@@ -20,6 +20,7 @@
 #include <QDateTime>
 #include <QColor>
 #include <QTreeWidgetItem>
+#include <QStandardItemModel>
 
 class Utils
 {
@@ -29,6 +30,7 @@ public:
     static QString breakLine(QString &details, int maxSize);
     static QColor getColorForStatus(const QString &status);
     static void setItemBoldFont(QTreeWidgetItem *item, bool bold);
+    static void appendRows(QStandardItemModel *model, const QList<QList<QStandardItem *>> &rows);
 
 private:
     Utils();
@@ -56,9 +56,17 @@ OBS::OBS(QObject *parent) : QObject(parent)
             this, &OBS::finishedParsingUploadFileRevision);
     connect(obsCore, &OBSCore::cannotUploadFile,
             this, &OBS::cannotUploadFile);
-    connect(obsCore, &OBSCore::fileFetched, this, &OBS::fileFetched);
+    connect(obsCore, &OBSCore::fileDownloaded, this, &OBS::fileDownloaded);
+    connect(obsCore, &OBSCore::downloadProgress, this, &OBS::downloadProgress);
+    connect(obsCore, &OBSCore::uploadProgress, this, &OBS::uploadProgress);
     connect(obsCore, &OBSCore::buildLogFetched, this, &OBS::buildLogFetched);
     connect(obsCore, &OBSCore::buildLogNotFound, this, &OBS::buildLogNotFound);
+    connect(obsCore, &OBSCore::buildLogAppended, this, &OBS::buildLogAppended);
+    connect(obsCore, &OBSCore::buildLogTailFinished, this, &OBS::buildLogTailFinished);
+    connect(obsCore, &OBSCore::buildLogStatusFetched, this, &OBS::buildLogStatusFetched);
+    connect(obsCore, &OBSCore::buildJobFetched, this, &OBS::buildJobFetched);
+    connect(obsCore, &OBSCore::lastSucceededBuildLogFetched, this, &OBS::lastSucceededBuildLogFetched);
+    connect(obsCore, &OBSCore::lastSucceededBuildLogNotFound, this, &OBS::lastSucceededBuildLogNotFound);
     connect(obsCore, &OBSCore::projectNotFound, this, &OBS::projectNotFound);
     connect(obsCore, &OBSCore::packageNotFound, this, &OBS::packageNotFound);
     connect(xmlReader, &OBSXmlReader::finishedParsingDeletePrjStatus,
@@ -71,26 +79,33 @@ OBS::OBS(QObject *parent) : QObject(parent)
     connect(obsCore, &OBSCore::cannotDeletePackage, this, &OBS::cannotDeletePackage);
     connect(obsCore, &OBSCore::cannotDeleteFile, this, &OBS::cannotDeleteFile);
 
-    connect(xmlReader, &OBSXmlReader::finishedParsingResult, this, &OBS::finishedParsingResult);
+    connect(xmlReader, &OBSXmlReader::finishedParsingResults, this, &OBS::finishedParsingResults);
     connect(xmlReader, &OBSXmlReader::finishedParsingResultList, this, &OBS::finishedParsingResultList);
-    connect(xmlReader, &OBSXmlReader::finishedParsingRevision,
-            this, &OBS::finishedParsingRevision);
+    connect(xmlReader, &OBSXmlReader::finishedParsingProjectResultList,
+            this, &OBS::finishedParsingProjectResultList);
+    connect(xmlReader, &OBSXmlReader::finishedParsingBuildResults, this, &OBS::finishedParsingBuildResults);
+    connect(xmlReader, &OBSXmlReader::finishedParsingBuildResultList, this, &OBS::finishedParsingBuildResultList);
+    connect(obsCore, &OBSCore::resultsChanged, this, &OBS::resultsChanged);
+    connect(obsCore, &OBSCore::staleDataLoaded, this, &OBS::staleDataLoaded);
+    connect(obsCore, &OBSCore::dataRevalidated, this, &OBS::dataRevalidated);
+    connect(xmlReader, &OBSXmlReader::finishedParsingRevisions,
+            this, &OBS::finishedParsingRevisions);
     connect(xmlReader, &OBSXmlReader::finishedParsingLatestRevision,
             this, &OBS::finishedParsingLatestRevision);
 
-    connect(xmlReader, &OBSXmlReader::finishedParsingRequest,
-            this, &OBS::finishedParsingRequest);
+    connect(xmlReader, &OBSXmlReader::finishedParsingRequests,
+            this, &OBS::finishedParsingRequests);
     connect(xmlReader, &OBSXmlReader::finishedParsingRequestList,
             this, &OBS::finishedParsingRequestList);
 
-    connect(xmlReader, &OBSXmlReader::finishedParsingIncomingRequest, this, &OBS::finishedParsingIncomingRequest);
+    connect(xmlReader, &OBSXmlReader::finishedParsingIncomingRequests, this, &OBS::finishedParsingIncomingRequests);
     connect(xmlReader, &OBSXmlReader::finishedParsingIncomingRequestList, this, &OBS::finishedParsingIncomingRequestList);
-    connect(xmlReader, &OBSXmlReader::finishedParsingOutgoingRequest, this, &OBS::finishedParsingOutgoingRequest);
+    connect(xmlReader, &OBSXmlReader::finishedParsingOutgoingRequests, this, &OBS::finishedParsingOutgoingRequests);
     connect(xmlReader, &OBSXmlReader::finishedParsingOutgoingRequestList, this, &OBS::finishedParsingOutgoingRequestList);
-    connect(xmlReader, &OBSXmlReader::finishedParsingDeclinedRequest, this, &OBS::finishedParsingDeclinedRequest);
+    connect(xmlReader, &OBSXmlReader::finishedParsingDeclinedRequests, this, &OBS::finishedParsingDeclinedRequests);
     connect(xmlReader, &OBSXmlReader::finishedParsingDeclinedRequestList, this, &OBS::finishedParsingDeclinedRequestList);
 
-    connect(xmlReader, &OBSXmlReader::projectFetched, this, &OBS::projectFetched);
+    connect(xmlReader, &OBSXmlReader::projectsFetched, this, &OBS::projectsFetched);
 
     connect(xmlReader, &OBSXmlReader::finishedParsingProjectList,
             this, &OBS::finishedParsingProjectList);
@@ -100,7 +115,7 @@ OBS::OBS(QObject *parent) : QObject(parent)
             this, &OBS::finishedParsingPackageList);
     connect(xmlReader, &OBSXmlReader::finishedParsingList,
             this, &OBS::finishedParsingList);
-    connect(xmlReader, &OBSXmlReader::finishedParsingFile, this, &OBS::finishedParsingFile);
+    connect(xmlReader, &OBSXmlReader::finishedParsingFiles, this, &OBS::finishedParsingFiles);
     connect(xmlReader, &OBSXmlReader::finishedParsingFileList,
             this, &OBS::finishedParsingFileList);
     connect(xmlReader, &OBSXmlReader::finishedParsingRevisionList,
@@ -171,12 +186,34 @@ void OBS::logout()
     obsCore->logout();
 }
 
+int OBS::createCancellationToken()
+{
+    return obsCore->createCancellationToken();
+}
+
+void OBS::setCancellationToken(int token)
+{
+    obsCore->setCancellationToken(token);
+}
+
+void OBS::cancelRequests(int token)
+{
+    obsCore->cancelRequests(token);
+}
+
 void OBS::getBuildStatus(const QStringList &stringList, int row)
 {
     //    URL format: https://api.opensuse.org/build/<project>/<repository>/<arch>/<package>/_status
     obsCore->getBuildStatus(stringList, row);
 }
 
+void OBS::getBuildResults(const QString &project, const QStringList &packages,
+                          const QStringList &repositories, const QStringList &archs)
+{
+    //    URL format: https://api.opensuse.org/build/<project>/_result?package=<package>&repository=<repository>&arch=<arch>
+    obsCore->getBuildResults(project, packages, repositories, archs);
+}
+
 void OBS::getPackageResults(const QString &project, const QString &package)
 {
     //    URL format: https://api.opensuse.org/build/<project>/_result?package=<package>
@@ -187,8 +224,33 @@ void OBS::getPackageResults(const QString &project, const QString &package)
 void OBS::getProjectResults(const QString &project)
 {
     //    URL format: https://api.opensuse.org/build/<project>/_result
-    QString resource = QString("%1/%2").arg(project, "_result");
-    obsCore->getResults(resource);
+    obsCore->getProjectResults(project);
+}
+
+QString OBS::watchProjectResults(const QString &project)
+{
+    //    URL format: https://api.opensuse.org/build/<project>/_result?oldstate=<state>
+    QString resource = OBSCore::createResultsResourceStr(project, QStringList(), QStringList(), QStringList());
+    obsCore->watchResults(project, resource);
+    return resource;
+}
+
+QString OBS::watchBuildResults(const QString &project, const QStringList &packages,
+                               const QStringList &repositories, const QStringList &archs)
+{
+    QString resource = OBSCore::createResultsResourceStr(project, packages, repositories, archs);
+    obsCore->watchResults(project, resource);
+    return resource;
+}
+
+void OBS::unwatchResults(const QString &resource)
+{
+    obsCore->unwatchResults(resource);
+}
+
+void OBS::unwatchAllResults()
+{
+    obsCore->unwatchAllResults();
 }
 
 void OBS::getLatestRevision(const QString &project, const QString &package)
@@ -211,11 +273,6 @@ void OBS::getDeclinedRequests()
     obsCore->getDeclinedRequests();
 }
 
-int OBS::getRequestCount()
-{
-    return xmlReader->getRequestNumber();
-}
-
 void OBS::getProjectRequests(const QString &project)
 {
     obsCore->getProjectRequests(project);
@@ -335,14 +392,15 @@ void OBS::createPackage(const QString &project, const QString &package, const QB
     obsCore->createPackage(project, package, data);
 }
 
-void OBS::uploadFile(const QString &project, const QString &package, const QString &fileName, const QByteArray &data)
+int OBS::uploadFile(const QString &project, const QString &package, const QString &fileName, const QString &path)
 {
-    obsCore->uploadFile(project, package, fileName, data);
+    return obsCore->uploadFile(project, package, fileName, path);
 }
 
-void OBS::downloadFile(const QString &project, const QString &package, const QString &fileName)
+void OBS::downloadFile(const QString &project, const QString &package, const QString &fileName,
+                       const QString &path)
 {
-    obsCore->downloadFile(project, package, fileName);
+    obsCore->downloadFile(project, package, fileName, path);
 }
 
 void OBS::getBuildLog(const QString &project, const QString &repository, const QString &arch, const QString &package)
@@ -350,6 +408,30 @@ void OBS::getBuildLog(const QString &project, const QString &repository, const Q
     obsCore->getBuildLog(project, repository, arch, package);
 }
 
+void OBS::getBuildLogTail(const QString &project, const QString &repository, const QString &arch,
+                          const QString &package, qint64 offset)
+{
+    obsCore->getBuildLogTail(project, repository, arch, package, offset);
+}
+
+void OBS::getBuildLogStatus(const QString &project, const QString &repository, const QString &arch,
+                            const QString &package)
+{
+    obsCore->getBuildLogStatus(project, repository, arch, package);
+}
+
+void OBS::getBuildJob(const QString &project, const QString &repository, const QString &arch,
+                      const QString &package)
+{
+    obsCore->getBuildJob(project, repository, arch, package);
+}
+
+void OBS::getLastSucceededBuildLog(const QString &project, const QString &repository, const QString &arch,
+                                   const QString &package)
+{
+    obsCore->getLastSucceededBuildLog(project, repository, arch, package);
+}
+
 void OBS::deleteProject(const QString &project)
 {
     obsCore->deleteProject(project);
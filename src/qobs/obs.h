@@ -42,13 +42,22 @@ public:
     bool isAuthenticated();
     void login();
     void logout();
+    int createCancellationToken();
+    void setCancellationToken(int token);
+    void cancelRequests(int token);
     void getBuildStatus(const QStringList &stringList, int row);
+    void getBuildResults(const QString &project, const QStringList &packages,
+                         const QStringList &repositories, const QStringList &archs);
     void getProjectResults(const QString &project);
+    QString watchProjectResults(const QString &project);
+    QString watchBuildResults(const QString &project, const QStringList &packages,
+                              const QStringList &repositories, const QStringList &archs);
+    void unwatchResults(const QString &resource);
+    void unwatchAllResults();
     void getLatestRevision(const QString &project, const QString &package);
     void getIncomingRequests();
     void getOutgoingRequests();
     void getDeclinedRequests();
-    int getRequestCount();
     void getProjectRequests(const QString &project);
     void getPackageRequests(const QString &project, const QString &package);
     void getRequestDiff(const QString &source);
@@ -103,9 +112,17 @@ signals:
     void cannotCreatePackage(QSharedPointer<OBSStatus> status);
     void finishedParsingUploadFileRevision(QSharedPointer<OBSRevision> revision);
     void cannotUploadFile(QSharedPointer<OBSStatus> status);
-    void fileFetched(const QString &fileName, const QByteArray &data);
+    void fileDownloaded(const QString &fileName, const QString &path);
+    void downloadProgress(const QString &fileName, qint64 bytesReceived, qint64 bytesTotal);
+    void uploadProgress(int token, const QString &fileName, qint64 bytesSent, qint64 bytesTotal);
     void buildLogFetched(const QString &buildLog);
     void buildLogNotFound();
+    void buildLogAppended(const QString &build, const QByteArray &data);
+    void buildLogTailFinished(const QString &build, bool ok);
+    void buildLogStatusFetched(const QString &build, const QString &code);
+    void buildJobFetched(const QString &build, const QString &job);
+    void lastSucceededBuildLogFetched(const QString &build, const QByteArray &data);
+    void lastSucceededBuildLogNotFound(const QString &build);
     void projectNotFound(QSharedPointer<OBSStatus> status);
     void packageNotFound(QSharedPointer<OBSStatus> status);
     void finishedParsingDeletePrjStatus(QSharedPointer<OBSStatus> status);
@@ -114,25 +131,31 @@ signals:
     void cannotDeleteProject(QSharedPointer<OBSStatus> status);
     void cannotDeletePackage(QSharedPointer<OBSStatus> status);
     void cannotDeleteFile(QSharedPointer<OBSStatus> status);
-    void finishedParsingResult(QSharedPointer<OBSResult> result);
-    void finishedParsingResultList(QList<QSharedPointer<OBSResult>> resultList);
-    void finishedParsingRevision(QSharedPointer<OBSRevision> revision);
-    void finishedParsingRequest(QSharedPointer<OBSRequest> request);
+    void finishedParsingResults(OBSResultSet resultSet);
+    void finishedParsingResultList(OBSResultSet resultSet);
+    void finishedParsingProjectResultList(const QString &project, OBSResultSet resultSet, const QString &state);
+    void finishedParsingBuildResults(const QString &project, OBSResultSet resultSet, int token);
+    void finishedParsingBuildResultList(const QString &project, int token);
+    void resultsChanged(const QString &resource, OBSResultSet resultSet);
+    void staleDataLoaded(const QString &resource);
+    void dataRevalidated(const QString &resource);
+    void finishedParsingRevisions(QList<QSharedPointer<OBSRevision>> revisionList);
+    void finishedParsingRequests(QList<QSharedPointer<OBSRequest>> requestList);
     void finishedParsingRequestList(const QString &project, const QString &package);
     void finishedParsingLatestRevision(QSharedPointer<OBSRevision> revision);
-    void finishedParsingIncomingRequest(QSharedPointer<OBSRequest> request);
-    void finishedParsingIncomingRequestList();
-    void finishedParsingOutgoingRequest(QSharedPointer<OBSRequest> request);
-    void finishedParsingOutgoingRequestList();
-    void finishedParsingDeclinedRequest(QSharedPointer<OBSRequest> request);
-    void finishedParsingDeclinedRequestList();
+    void finishedParsingIncomingRequests(QList<QSharedPointer<OBSRequest>> requestList);
+    void finishedParsingIncomingRequestList(int count);
+    void finishedParsingOutgoingRequests(QList<QSharedPointer<OBSRequest>> requestList);
+    void finishedParsingOutgoingRequestList(int count);
+    void finishedParsingDeclinedRequests(QList<QSharedPointer<OBSRequest>> requestList);
+    void finishedParsingDeclinedRequestList(int count);
     void finishedParsingProjectList(const QStringList &projectList);
-    void projectFetched(const QString &project);
+    void projectsFetched(const QStringList &projectList);
     void finishedParsingProjectMetaConfig(QSharedPointer<OBSPrjMetaConfig> prjMetaConfig);
     void finishedParsingPackageMetaConfig(QSharedPointer<OBSPkgMetaConfig> pkgMetaConfig);
     void finishedParsingPackageList(const QStringList &packageList);
     void finishedParsingList(const QStringList &list);
-    void finishedParsingFile(QSharedPointer<OBSFile> file);
+    void finishedParsingFiles(QList<QSharedPointer<OBSFile>> fileList);
     void finishedParsingFileList(const QString &project, const QString &package);
     void finishedParsingRevisionList(const QString &project, const QString &package);
     void finishedParsingLink(QSharedPointer<OBSLink> link);
@@ -150,9 +173,18 @@ public slots:
     void createRequest(const QByteArray &data);
     void createProject(const QString &project, const QByteArray &data);
     void createPackage(const QString &project, const QString &package, const QByteArray &data);
-    void uploadFile(const QString &project, const QString &package, const QString &fileName, const QByteArray &data);
-    void downloadFile(const QString &project, const QString &package, const QString &fileName);
+    int uploadFile(const QString &project, const QString &package, const QString &fileName, const QString &path);
+    void downloadFile(const QString &project, const QString &package, const QString &fileName,
+                      const QString &path);
     void getBuildLog(const QString &project, const QString &repository, const QString &arch, const QString &package);
+    void getBuildLogTail(const QString &project, const QString &repository, const QString &arch,
+                         const QString &package, qint64 offset);
+    void getBuildLogStatus(const QString &project, const QString &repository, const QString &arch,
+                           const QString &package);
+    void getBuildJob(const QString &project, const QString &repository, const QString &arch,
+                     const QString &package);
+    void getLastSucceededBuildLog(const QString &project, const QString &repository, const QString &arch,
+                                  const QString &package);
 };
 
 #endif // OBS_H
@@ -15,17 +15,53 @@
  */
 #include "obscore.h"
 #include "obsstatus.h"
+#include <QTimer>
+#include <QFile>
+#include <QDataStream>
+#include <QStandardPaths>
 
 OBSCore *OBSCore::instance = nullptr;
 const QString userAgent = APP_NAME + QString(" ") + QACTUS_VERSION;
 
-OBSCore::OBSCore()
+// Watched results are re-requested with oldstate=<state>, which OBS keeps
+// open until the state changes. Failed (or non-blocking) requests back off
+// from minWatchRetryDelay up to maxWatchRetryDelay (msec)
+const int minWatchRetryDelay = 5000;
+const int maxWatchRetryDelay = 300000;
+
+// Max size of the conditional request cache (KiB)
+const int maxReplyCacheCost = 32 * 1024;
+// Max size of its copy on disk (bytes)
+const qint64 maxResponseCacheSize = 100 * 1024 * 1024;
+
+// Streamed downloads are read from the socket in chunks of up to this size
+const qint64 downloadBufferSize = 256 * 1024;
+
+OBSCore::OBSCore() :
+    responseCache(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/responses",
+                  maxResponseCacheSize)
 {
     m_authenticated = false;
     xmlReader = OBSXmlReader::getInstance();
     manager = nullptr;
     includeHomeProjects = false;
     linkHelper = nullptr;
+    replyCache.setMaxCost(maxReplyCacheCost);
+    cacheWriter = new QThreadPool(this);
+    cacheWriter->setMaxThreadCount(1);
+    cancellationToken = 0;
+    lastCancellationToken = 0;
+
+    scheduler = new OBSRequestScheduler(this);
+    connect(scheduler, &OBSRequestScheduler::started, this, &OBSCore::onRequestStarted);
+    connect(scheduler, &OBSRequestScheduler::canceled, this, &OBSCore::onRequestCanceled);
+
+    // Results are parsed on the parser threads
+    connect(xmlReader, &OBSXmlReader::finishedParsingWatchedResults, this, &OBSCore::onWatchedResultsParsed);
+    connect(xmlReader, &OBSXmlReader::finishedParsingProjectResultList, this,
+            [this](const QString &project, const OBSResultSet &, const QString &state) {
+        onProjectResultsParsed(project, state);
+    });
 }
 
 void OBSCore::createManager()
@@ -36,6 +72,7 @@ void OBSCore::createManager()
             this, &OBSCore::provideAuthentication);
     connect(manager, &QNetworkAccessManager::finished, this, &OBSCore::replyFinished);
     connect(manager, &QNetworkAccessManager::sslErrors, this, &OBSCore::onSslErrors);
+    scheduler->setManager(manager);
 }
 
 OBSCore *OBSCore::getInstance()
@@ -50,6 +87,14 @@ void OBSCore::setCredentials(const QString& username, const QString& password)
 {
     qDebug() << Q_FUNC_INFO;
 //    Allow login with another username/password
+//    Watch replies are owned by the manager
+    watchReplies.clear();
+    watchParsing.clear();
+    seedingResults.clear();
+    requests.clear();
+    pendingRequests.clear();
+    replyCache.clear();
+    receivedData.clear();
     if (manager) {
         delete manager;
         manager = nullptr;
@@ -65,10 +110,17 @@ void OBSCore::onReadyToLinkPackage(const QString &dstProject, const QString &dst
     qDebug() << Q_FUNC_INFO;
     QString resource = QString("/source/%1/%2/_link").arg(dstProject, dstPackage);
 
-    QNetworkReply *reply = putRequest(resource, data);
-    reply->setProperty("reqtype", OBSCore::LinkPackage);
-    reply->setProperty("destprj", dstProject);
-    reply->setProperty("destpkg", dstPackage);
+    quint64 requestId = putRequest(resource, data);
+    setHandler(requestId, OBSCore::LinkPackage, [this, dstProject, dstPackage](QNetworkReply *, const QByteArray &data) {
+        xmlReader->parseInBackground(&OBSXmlReader::parseLinkPackage, dstProject, dstPackage, data);
+    }, [this, dstProject, dstPackage](QNetworkReply *reply, const QByteArray &) {
+        if (reply->error() == QNetworkReply::ContentNotFoundError) {
+            QString details = QString("The package %2 in project %1 does NOT exist.").arg(dstProject, dstPackage);
+            emit cannotLinkPackage(createErrorStatus(dstProject, dstPackage, "Cannot link", details));
+            return true;
+        }
+        return false;
+    });
 
     if (linkHelper) {
         delete linkHelper;
@@ -93,8 +145,15 @@ QString OBSCore::getApiUrl() const
 
 void OBSCore::login()
 {
-    QNetworkReply *reply = request("/");
-    reply->setProperty("reqtype", OBSCore::Login);
+    quint64 requestId = request("/");
+    setHandler(requestId, OBSCore::Login, nullptr, [this](QNetworkReply *reply, const QByteArray &) {
+        if (reply->error() == QNetworkReply::ContentNotFoundError) {
+            qDebug() << Q_FUNC_INFO << "OBS API not found at" << reply->url().toString();
+            emit apiNotFound(reply->url());
+            return true;
+        }
+        return false;
+    });
 }
 
 void OBSCore::logout()
@@ -102,29 +161,127 @@ void OBSCore::logout()
     m_authenticated = false;
 }
 
-QNetworkReply *OBSCore::request(const QString &resource)
+QNetworkRequest OBSCore::createGetRequest(const QString &resource) const
 {
     QNetworkRequest request;
     request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, true);
     request.setUrl(QUrl(apiUrl + resource));
     qDebug() << Q_FUNC_INFO << "User-Agent:" << userAgent;
-    request.setRawHeader("User-Agent", userAgent.toLatin1());  
-    QNetworkReply *reply = manager->get(request);
-    return reply;
+    request.setRawHeader("User-Agent", userAgent.toLatin1());
+    return request;
+}
+
+quint64 OBSCore::request(const QString &resource)
+{
+    return scheduler->enqueue(QNetworkAccessManager::GetOperation, createGetRequest(resource),
+                              QByteArray(), cancellationToken);
+}
+
+quint64 OBSCore::conditionalRequest(const QString &resource)
+{
+    QNetworkRequest request = createGetRequest(resource);
+    CachedReply *cachedReply = getCachedReply(request.url());
+    if (cachedReply) {
+        if (!cachedReply->eTag.isEmpty()) {
+            request.setRawHeader("If-None-Match", cachedReply->eTag);
+        }
+        if (!cachedReply->lastModified.isEmpty()) {
+            request.setRawHeader("If-Modified-Since", cachedReply->lastModified);
+        }
+    }
+
+    quint64 requestId = scheduler->enqueue(QNetworkAccessManager::GetOperation, request,
+                                           QByteArray(), cancellationToken);
+    RequestInfo &info = pendingRequests[requestId];
+    info.conditional = true;
+    info.token = cancellationToken;
+    return requestId;
+}
+
+QString OBSCore::createCacheKey(const QUrl &url) const
+{
+    // The URL already contains the API URL
+    return username + " " + url.toString();
+}
+
+OBSCore::CachedReply *OBSCore::getCachedReply(const QUrl &url)
+{
+    QString key = createCacheKey(url);
+    CachedReply *cachedReply = replyCache.object(key);
+    if (!cachedReply) {
+        QByteArray entry;
+        if (!responseCache.read(key, entry)) {
+            return nullptr;
+        }
+        cachedReply = new CachedReply;
+        QDataStream in(entry);
+        in >> cachedReply->eTag >> cachedReply->lastModified >> cachedReply->data;
+        replyCache.insert(key, cachedReply, qMax(1, int(cachedReply->data.size() / 1024)));
+        // QCache may delete the object right away if it doesn't fit
+        cachedReply = replyCache.object(key);
+    }
+    return cachedReply;
+}
+
+// Returns false if the reply is a 304 whose cached body is gone
+bool OBSCore::updateReplyCache(QNetworkReply *reply, QByteArray &data, int httpStatusCode)
+{
+    QUrl url = reply->request().url();
+
+    if (httpStatusCode == 304) {
+        CachedReply *cachedReply = getCachedReply(url);
+        if (!cachedReply) {
+            qDebug() << Q_FUNC_INFO << "Not modified, but no cached reply for" << url.toString();
+            return false;
+        }
+        qDebug() << Q_FUNC_INFO << "Not modified, using cached reply for" << url.toString();
+        data = cachedReply->data;
+    } else if (httpStatusCode == 200) {
+        QString key = createCacheKey(url);
+        CachedReply *cachedReply = new CachedReply;
+        cachedReply->eTag = reply->rawHeader("ETag");
+        cachedReply->lastModified = reply->rawHeader("Last-Modified");
+        cachedReply->data = data;
+        QByteArray eTag = cachedReply->eTag;
+        QByteArray lastModified = cachedReply->lastModified;
+        cacheWriter->start([this, key, eTag, lastModified, data]() {
+            QByteArray entry;
+            QDataStream out(&entry, QIODevice::WriteOnly);
+            out << eTag << lastModified << data;
+            responseCache.write(key, entry);
+        });
+        replyCache.insert(key, cachedReply, qMax(1, int(data.size() / 1024)));
+    }
+    return true;
+}
+
+// The cached reply was evicted after the request was sent with its validators.
+// Coalesced requests share the token of the conditional one.
+void OBSCore::resendUnconditionally(QNetworkReply *reply, const QList<RequestInfo> &infos, int token)
+{
+    QNetworkRequest request = reply->request();
+    request.setRawHeader("If-None-Match", QByteArray());
+    request.setRawHeader("If-Modified-Since", QByteArray());
+
+    foreach (const RequestInfo &info, infos) {
+        quint64 requestId = scheduler->enqueue(QNetworkAccessManager::GetOperation, request,
+                                               QByteArray(), token);
+        pendingRequests.insert(requestId, info);
+        scheduler->setPriority(requestId, getPriority(info.type));
+    }
 }
 
 void OBSCore::request(QNetworkReply *reply)
 {
     QString resource = reply->url().toString();
-    QNetworkReply *newReply = request(resource);
-    newReply->setProperty("reqtype", reply->property("reqtype"));
+    quint64 requestId = request(resource);
 
-    if (reply->property("row").isValid()) {
-        newReply->setProperty("row", reply->property("row").toInt());
+    if (requests.contains(reply)) {
+        pendingRequests.insert(requestId, requests.value(reply));
     }
 }
 
-QNetworkReply *OBSCore::requestBuild(const QString &resource)
+quint64 OBSCore::requestBuild(const QString &resource)
 {
     return request("/build/" + resource);
 }
@@ -132,17 +289,198 @@ QNetworkReply *OBSCore::requestBuild(const QString &resource)
 void OBSCore::getBuildStatus(const QStringList &build, int row)
 {
     QString resource = QString("%1/%2/%3/%4/_status").arg(build[0], build[1], build[2], build[3]);
-    QNetworkReply *reply = requestBuild(resource);
-    reply->setProperty("reqtype", OBSCore::BuildStatus);
-    reply->setProperty("row", row);
+    quint64 requestId = requestBuild(resource);
+    setBuildStatusHandler(requestId, row);
+}
+
+QString OBSCore::createResultsResourceStr(const QString &project, const QStringList &packages,
+                                         const QStringList &repositories, const QStringList &archs)
+{
+    QStringList query;
+    foreach (const QString &package, packages) {
+        query.append("package=" + QUrl::toPercentEncoding(package));
+    }
+    foreach (const QString &repository, repositories) {
+        query.append("repository=" + QUrl::toPercentEncoding(repository));
+    }
+    foreach (const QString &arch, archs) {
+        query.append("arch=" + QUrl::toPercentEncoding(arch));
+    }
+
+    if (query.isEmpty()) {
+        return QString("%1/_result").arg(project);
+    }
+    return QString("%1/_result?%2").arg(project, query.join("&"));
+}
+
+void OBSCore::getBuildResults(const QString &project, const QStringList &packages,
+                              const QStringList &repositories, const QStringList &archs)
+{
+    QString resource = createResultsResourceStr(project, packages, repositories, archs);
+    quint64 requestId = requestBuild(resource);
+    // The results are tagged with the token, which tells receivers which round they belong to
+    OBSParseContext context;
+    context.project = project;
+    context.token = cancellationToken;
+    setStreamHandler(requestId, OBSCore::BuildResults, &OBSXmlReader::parseBuildResultsStream, context,
+                     [project](QNetworkReply *reply, const QByteArray &) {
+        // The stream ends the list; the missing rows get their own _status
+        if (reply->error() == QNetworkReply::ContentNotFoundError) {
+            qDebug() << Q_FUNC_INFO << "Build results not found for" << project;
+            return true;
+        }
+        return false;
+    });
+}
+
+void OBSCore::watchResults(const QString &project, const QString &resource)
+{
+    qDebug() << Q_FUNC_INFO << resource;
+    watchedResults.insert(resource, project);
+    watchCounts[resource]++;
+    // A project results request on its way starts the watch with its state
+    if (!seedingResults.contains(resource)) {
+        requestWatchedResults(resource);
+    }
+}
+
+void OBSCore::unwatchResults(const QString &resource)
+{
+    qDebug() << Q_FUNC_INFO << resource;
+    // A resource can be watched more than once (e.g. by several monitor tabs)
+    if (--watchCounts[resource] > 0) {
+        return;
+    }
+    watchCounts.remove(resource);
+    watchedResults.remove(resource);
+    watchedStates.remove(resource);
+    watchRetryDelays.remove(resource);
+
+    QNetworkReply *reply = watchReplies.take(resource);
+    if (reply) {
+        reply->abort();
+    }
+}
+
+void OBSCore::unwatchAllResults()
+{
+    watchCounts.clear();
+    foreach (const QString &resource, watchedResults.keys()) {
+        unwatchResults(resource);
+    }
+}
+
+void OBSCore::requestWatchedResults(const QString &resource)
+{
+    if (!manager || !watchedResults.contains(resource) || watchReplies.contains(resource)
+            || watchParsing.contains(resource)) {
+        return;
+    }
+
+    QString watchResource = resource;
+    QString state = watchedStates.value(resource);
+    if (!state.isEmpty()) {
+        watchResource += (resource.contains("?") ? "&" : "?") + QString("oldstate=") + state;
+    }
+
+    // Long-polls are not queued, they would take up the slots of other requests
+    QNetworkReply *reply = manager->get(createGetRequest("/build/" + watchResource));
+    qint64 start = QDateTime::currentMSecsSinceEpoch();
+
+    // Watch requests are long-lived and handle their own errors
+    ReplyHandler handler = [this, resource, start](QNetworkReply *reply, const QByteArray &data) {
+        watchReplyFinished(reply, data, resource, start);
+    };
+    setHandler(reply, OBSCore::WatchResults, handler, [handler](QNetworkReply *reply, const QByteArray &data) {
+        handler(reply, data);
+        return true;
+    });
+    watchReplies.insert(resource, reply);
+}
+
+void OBSCore::retryWatchedResults(const QString &resource)
+{
+    int delay = qBound(minWatchRetryDelay, watchRetryDelays.value(resource) * 2, maxWatchRetryDelay);
+    watchRetryDelays.insert(resource, delay);
+    qDebug() << Q_FUNC_INFO << resource << "retrying in" << delay << "ms";
+    QTimer::singleShot(delay, this, [this, resource]() {
+        requestWatchedResults(resource);
+    });
+}
+
+void OBSCore::watchReplyFinished(QNetworkReply *reply, const QByteArray &data,
+                                 const QString &resource, qint64 start)
+{
+    if (watchReplies.value(resource) != reply) {
+        // Unwatched or superseded
+        return;
+    }
+    watchReplies.remove(resource);
+
+    if (reply->error() != QNetworkReply::NoError) {
+        qDebug() << Q_FUNC_INFO << resource << reply->errorString();
+        retryWatchedResults(resource);
+        return;
+    }
+
+    // Project result lists can be large, they are parsed on the parser threads
+    watchParsing.insert(resource, QDateTime::currentMSecsSinceEpoch() - start);
+    xmlReader->parseInBackground(&OBSXmlReader::parseWatchedResults, resource, data);
+}
+
+void OBSCore::onWatchedResultsParsed(const QString &resource, const OBSResultSet &resultSet,
+                                     const QString &state)
+{
+    if (!watchParsing.contains(resource)) {
+        // Credentials changed meanwhile
+        return;
+    }
+    qint64 elapsed = watchParsing.take(resource);
+    if (!watchedResults.contains(resource)) {
+        // Unwatched meanwhile
+        return;
+    }
+    QString oldState = watchedStates.value(resource);
+
+    if (state.isEmpty()) {
+        retryWatchedResults(resource);
+        return;
+    }
+    watchedStates.insert(resource, state);
+
+    if (state != oldState) {
+        watchRetryDelays.remove(resource);
+        emit resultsChanged(resource, resultSet);
+        requestWatchedResults(resource);
+    } else if (elapsed < minWatchRetryDelay) {
+        // The server didn't block on oldstate
+        retryWatchedResults(resource);
+    } else {
+        requestWatchedResults(resource);
+    }
+}
+
+void OBSCore::onProjectResultsParsed(const QString &project, const QString &state)
+{
+    QString resource = createResultsResourceStr(project, QStringList(), QStringList(), QStringList());
+    if (!seedingResults.contains(resource)) {
+        return;
+    }
+    seedingResults.remove(resource);
+
+    // The watch starts from the state of the results which are shown
+    if (watchedResults.contains(resource) && !state.isEmpty() && !watchedStates.contains(resource)) {
+        watchedStates.insert(resource, state);
+    }
+    requestWatchedResults(resource);
 }
 
-QNetworkReply *OBSCore::requestSource(const QString &resource)
+quint64 OBSCore::requestSource(const QString &resource)
 {
     return request("/source/" + resource);
 }
 
-QNetworkReply *OBSCore::requestRequest(const QString &resource)
+quint64 OBSCore::requestRequest(const QString &resource)
 {
     return request("/request/" + resource);
 }
@@ -156,28 +494,29 @@ QString OBSCore::createReqResourceStr(const QString &states, const QString &role
 void OBSCore::getRequests(OBSCore::RequestType type)
 {
     QString resource;
-    QNetworkReply *reply = nullptr;
+    OBSXmlStream::Parser parser = nullptr;
 
     switch (type) {
     case OBSCore::IncomingRequests:
         resource = createReqResourceStr("new", "maintainer");
-        reply = request(resource);
+        parser = &OBSXmlReader::parseIncomingRequestsStream;
         break;
     case OBSCore::OutgoingRequests:
         resource = createReqResourceStr("new,review", "creator");
-        reply = request(resource);
+        parser = &OBSXmlReader::parseOutgoingRequestsStream;
         break;
     case OBSCore::DeclinedRequests:
         resource = createReqResourceStr("declined", "creator");
-        reply = request(resource);
+        parser = &OBSXmlReader::parseDeclinedRequestsStream;
         break;
     default:
         qDebug() << Q_FUNC_INFO <<"request type not handled!";
         break;
     }
 
-    if (reply) {
-        reply->setProperty("reqtype", type);
+    if (parser) {
+        quint64 requestId = request(resource);
+        setStreamHandler(requestId, type, parser);
     }
 }
 
@@ -202,9 +541,11 @@ void OBSCore::getProjectRequests(const QString &project)
     QString states = "new,review";
     QString resource = QString("?view=collection&types=%1&states=%2&project=%3")
             .arg(types, states, project);
-    QNetworkReply *reply = requestRequest(resource);
-    reply->setProperty("reqtype", OBSCore::ProjectRequests);
-    reply->setProperty("prjreq", project);
+    quint64 requestId = requestRequest(resource);
+
+    OBSParseContext context;
+    context.project = project;
+    setStreamHandler(requestId, OBSCore::ProjectRequests, &OBSXmlReader::parseRequestsStream, context);
 }
 
 void OBSCore::getPackageRequests(const QString &project, const QString &package)
@@ -213,10 +554,12 @@ void OBSCore::getPackageRequests(const QString &project, const QString &package)
     QString states = "new,review";
     QString resource = QString("?view=collection&types=%1&states=%2&project=%3&package=%4")
             .arg(types, states, project, package);
-    QNetworkReply *reply = requestRequest(resource);
-    reply->setProperty("reqtype", OBSCore::PackageRequests);
-    reply->setProperty("prjreq", project);
-    reply->setProperty("pkgreq", package);
+    quint64 requestId = requestRequest(resource);
+
+    OBSParseContext context;
+    context.project = project;
+    context.package = package;
+    setStreamHandler(requestId, OBSCore::PackageRequests, &OBSXmlReader::parseRequestsStream, context);
 }
 
 bool OBSCore::isIncludeHomeProjects() const
@@ -231,123 +574,156 @@ void OBSCore::setIncludeHomeProjects(bool value)
 
 void OBSCore::getProjects()
 {
-    QNetworkReply *reply = requestSource("");
-    reply->setProperty("reqtype", OBSCore::ProjectList);
+    quint64 requestId = conditionalRequest("/source/");
     QString userHome = includeHomeProjects ? "" : "home:" + username;
-    reply->setProperty("includehomeprjs", userHome);
+    OBSParseContext context;
+    context.userHome = userHome;
+    setStreamHandler(requestId, OBSCore::ProjectList, &OBSXmlReader::parseProjectListStream, context);
+
+    // Stale-while-revalidate: show the cached list right away,
+    // the reply will update it only if it has changed
+    QUrl url = createGetRequest("/source/").url();
+    CachedReply *cachedReply = getCachedReply(url);
+    if (cachedReply) {
+        QString resource = url.toString();
+        QByteArray data = cachedReply->data;
+        pendingRequests[requestId].revalidate = true;
+        QTimer::singleShot(0, this, [this, resource, userHome, data]() {
+            xmlReader->parseInBackground(&OBSXmlReader::parseProjectList, userHome, data);
+            emit staleDataLoaded(resource);
+        });
+    }
 }
 
 void OBSCore::getProjectMetaConfig(const QString &resource)
 {
-    QNetworkReply *reply = requestSource(resource);
-    reply->setProperty("reqtype", OBSCore::PrjMetaConfig);
+    quint64 requestId = conditionalRequest("/source/" + resource);
+    setHandler(requestId, OBSCore::PrjMetaConfig, parseWith(&OBSXmlReader::parsePrjMetaConfig));
 }
 
 void OBSCore::getPackageMetaConfig(const QString &resource)
 {
-    QNetworkReply *reply = requestSource(resource);
-    reply->setProperty("reqtype", OBSCore::PkgMetaConfig);
+    quint64 requestId = conditionalRequest("/source/" + resource);
+    setHandler(requestId, OBSCore::PkgMetaConfig, parseWith(&OBSXmlReader::parsePkgMetaConfig));
 }
 
 void OBSCore::getPackages(const QString &resource)
 {
-    QNetworkReply *reply = requestSource(resource);
-    reply->setProperty("reqtype", OBSCore::PackageList);
+    quint64 requestId = conditionalRequest("/source/" + resource);
+    setHandler(requestId, OBSCore::PackageList, parseWith(&OBSXmlReader::parsePackageList),
+               [this](QNetworkReply *reply, const QByteArray &data) {
+        if (reply->error() == QNetworkReply::ContentNotFoundError) {
+            if (isAuthenticated()) {
+                QSharedPointer<OBSStatus> status = xmlReader->parseNotFoundStatus(data);
+                qDebug() << Q_FUNC_INFO << "Project not found!" << status->getSummary() << status->getCode();
+                emit projectNotFound(status);
+            }
+            return true;
+        }
+        return false;
+    });
 }
 
 void OBSCore::getFiles(const QString &project, const QString &package)
 {
     QString resource = QString("%1/%2").arg(project, package);
-    QNetworkReply *reply = requestSource(resource);
-    reply->setProperty("reqtype", OBSCore::FileList);
-    reply->setProperty("prjfile", project);
-    reply->setProperty("pkgfile", package);
+    quint64 requestId = requestSource(resource);
+    setHandler(requestId, OBSCore::FileList, [this, project, package](QNetworkReply *, const QByteArray &data) {
+        xmlReader->parseInBackground(&OBSXmlReader::parseFileList, project, package, data);
+    }, packageNotFoundHandler());
 }
 
 void OBSCore::getRevisions(const QString &project, const QString &package)
 {
-    QString resource = QString("%1/%2/_history").arg(project, package);
-    QNetworkReply *reply = requestSource(resource);
-    reply->setProperty("reqtype", OBSCore::RevisionList);
-    reply->setProperty("prjrev", project);
-    reply->setProperty("pkgrev", package);
+    QString resource = QString("/source/%1/%2/_history").arg(project, package);
+    quint64 requestId = conditionalRequest(resource);
+    setHandler(requestId, OBSCore::RevisionList, [this, project, package](QNetworkReply *, const QByteArray &data) {
+        xmlReader->parseInBackground(&OBSXmlReader::parseRevisionList, project, package, data);
+    }, packageNotFoundHandler());
 }
 
 void OBSCore::getLatestRevision(const QString &project, const QString &package)
 {
-    QString resource = QString("%1/%2/_history?limit=1").arg(project, package);
-    QNetworkReply *reply = requestSource(resource);
-    reply->setProperty("reqtype", OBSCore::LatestRevision);
-    reply->setProperty("prjrev", project);
-    reply->setProperty("pkgrev", package);
+    QString resource = QString("/source/%1/%2/_history?limit=1").arg(project, package);
+    quint64 requestId = conditionalRequest(resource);
+    setHandler(requestId, OBSCore::LatestRevision, [this, project, package](QNetworkReply *, const QByteArray &data) {
+        xmlReader->parseInBackground(&OBSXmlReader::parseLatestRevision, project, package, data);
+    }, packageNotFoundHandler());
 }
 
 void OBSCore::getLink(const QString &project, const QString &package)
 {
     QString resource = QString("/source/%1/%2/_link").arg(project, package);
-    QNetworkReply *reply = request(resource);
-    reply->setProperty("reqtype", OBSCore::Link);
+    quint64 requestId = request(resource);
+    setHandler(requestId, OBSCore::Link, parseWith(&OBSXmlReader::parseLink));
 }
 
 void OBSCore::getResults(const QString &resource)
 {
-    QNetworkReply *reply = requestBuild(resource);
-    reply->setProperty("reqtype", OBSCore::BuildStatusList);
+    quint64 requestId = requestBuild(resource);
+    setStreamHandler(requestId, OBSCore::BuildStatusList, &OBSXmlReader::parseResultListStream);
+}
+
+// The project in the context tells that the list has all the project results
+void OBSCore::getProjectResults(const QString &project)
+{
+    QString resource = createResultsResourceStr(project, QStringList(), QStringList(), QStringList());
+    quint64 requestId = requestBuild(resource);
+    seedingResults.insert(resource, requestId);
+    OBSParseContext context;
+    context.project = project;
+    setStreamHandler(requestId, OBSCore::BuildStatusList, &OBSXmlReader::parseResultListStream, context);
 }
 
 void OBSCore::request(const QString &resource, int row)
 {
-    QNetworkReply *reply = request(resource);
-    reply->setProperty("reqtype", OBSCore::BuildStatus);
-    reply->setProperty("row", row);
+    quint64 requestId = request(resource);
+    setBuildStatusHandler(requestId, row);
 }
 
-QNetworkReply *OBSCore::postRequest(const QString &resource, const QByteArray &data, const QString &contentTypeHeader)
+quint64 OBSCore::postRequest(const QString &resource, const QByteArray &data, const QString &contentTypeHeader)
 {
     QNetworkRequest request;
     request.setUrl(QUrl(apiUrl + resource));
     qDebug() << Q_FUNC_INFO << "User-Agent:" << userAgent;
     request.setRawHeader("User-Agent", userAgent.toLatin1());
     request.setHeader(QNetworkRequest::ContentTypeHeader, contentTypeHeader);
-    QNetworkReply *reply = manager->post(request, data);
 
-    return reply;
+    return scheduler->enqueue(QNetworkAccessManager::PostOperation, request, data, cancellationToken);
 }
 
-QNetworkReply *OBSCore::putRequest(const QString &resource, const QByteArray &data)
+quint64 OBSCore::putRequest(const QString &resource, const QByteArray &data)
 {
     QNetworkRequest request;
     request.setUrl(QUrl(apiUrl + resource));
     qDebug() << Q_FUNC_INFO << "User-Agent:" << userAgent;
     request.setRawHeader("User-Agent", userAgent.toLatin1());
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/xml");
-    QNetworkReply *reply = manager->put(request, data);
 
-    return reply;
+    return scheduler->enqueue(QNetworkAccessManager::PutOperation, request, data, cancellationToken);
 }
 
-QNetworkReply *OBSCore::deleteRequest(const QString &resource)
+quint64 OBSCore::deleteRequest(const QString &resource)
 {
     QNetworkRequest request;
     request.setUrl(QUrl(apiUrl + resource));
     request.setRawHeader("User-Agent", userAgent.toLatin1());
-    QNetworkReply *reply = manager->deleteResource(request);
 
-    return reply;
+    return scheduler->enqueue(QNetworkAccessManager::DeleteOperation, request, QByteArray(), cancellationToken);
 }
 
 void OBSCore::changeSubmitRequest(const QString &resource, const QByteArray &data)
 {
-    QNetworkReply *reply = postRequest(resource, data, "application/x-www-form-urlencoded");
-    reply->setProperty("reqtype", OBSCore::ChangeRequestState);
+    quint64 requestId = postRequest(resource, data, "application/x-www-form-urlencoded");
+    setHandler(requestId, OBSCore::ChangeRequestState, parseWith(&OBSXmlReader::parseRequestStatus));
 }
 
 void OBSCore::packageSearch(const QString &package)
 {
     QString resource = QString("/search/package?match=starts_with(@name,'%1')&limit=20")
                            .arg(package);
-    QNetworkReply *reply = request(resource);
-    reply->setProperty("reqtype", OBSCore::PackageSearch);
+    quint64 requestId = request(resource);
+    setHandler(requestId, OBSCore::PackageSearch, parseWith(&OBSXmlReader::parsePackageSearch));
 }
 
 void OBSCore::provideAuthentication(QNetworkReply *reply, QAuthenticator *authenticator)
@@ -372,9 +748,32 @@ void OBSCore::replyFinished(QNetworkReply *reply)
     QByteArray data = reply->readAll();
 
     int httpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+    // Streamed replies have already handed what they received to their handlers.
+    // The entry is taken also when the reply failed or was aborted
+    QByteArray unreadData = data;
+    bool streamed = httpStatusCode == 200 && receivedData.contains(reply);
+    if (receivedData.contains(reply)) {
+        data.prepend(receivedData.take(reply));
+    }
     qDebug() << Q_FUNC_INFO << reply->url().toString() << httpStatusCode;
 //    qDebug() << "Network Reply: " << data;
 
+    // Coalesced requests share the reply, each one has its own info
+    QList<RequestInfo> infos = requests.values(reply);
+    requests.remove(reply);
+
+    foreach (const RequestInfo &info, infos) {
+        if (info.conditional) {
+            if (!updateReplyCache(reply, data, httpStatusCode)) {
+                resendUnconditionally(reply, infos, info.token);
+                reply->deleteLater();
+                return;
+            }
+            break;
+        }
+    }
+
     if (httpStatusCode == 200 && !m_authenticated) {
         m_authenticated = true;
         emit authenticated(m_authenticated);
@@ -383,570 +782,259 @@ void OBSCore::replyFinished(QNetworkReply *reply)
         emit authenticated(m_authenticated);
     }
 
-    /* Set package row always (error/no error) if property is valid.
-     * Needed for inserting the build status
-     */
-    if(reply->property("row").isValid()) {
-        int row = reply->property("row").toInt();
-        qDebug() << Q_FUNC_INFO << "Reply row property:" << QString::number(row);
-        xmlReader->setPackageRow(row);
-    }
-
-    QString reqTypeStr = "RequestType";
-
-    switch (reply->error()) {
-
-    case QNetworkReply::NoError: {
-        if (reply->property("reqtype").isValid()) {
-            QString reqTypeStr = "RequestType";
-            int reqType = reply->property("reqtype").toInt();
-
-            QString dataStr;
-            if (reqType != OBSCore::DownloadFile) {
-                dataStr = QString::fromUtf8(data);
-            }
-
-            switch(reqType) {
-
-            case OBSCore::Login: // <html>
-                // do nothing
-                break;
-
-            case OBSCore::ProjectList: { // <directory>
-                QString userHome;
-                if (reply->property("includehomeprjs").isValid()) {
-                    userHome = reply->property("includehomeprjs").toString();
-                }
-                xmlReader->parseProjectList(userHome, dataStr);
-                break;
-            }
-
-            case OBSCore::PrjMetaConfig: // <project>
-                xmlReader->parsePrjMetaConfig(dataStr);
-                break;
-
-            case OBSCore::PkgMetaConfig: // <package>
-                xmlReader->parsePkgMetaConfig(dataStr);
-                break;
-
-            case OBSCore::PackageList: // <directory>
-                xmlReader->parsePackageList(dataStr);
-                break;
-
-            case OBSCore::FileList: { // <directory>
-                QString project;
-                QString package;
-                if (reply->property("prjfile").isValid()) {
-                    project = reply->property("prjfile").toString();
-                }
-                if (reply->property("pkgfile").isValid()) {
-                    package = reply->property("pkgfile").toString();
-                }
-                xmlReader->parseFileList(project, package, dataStr);
-                break;
-            }
-
-            case OBSCore::RevisionList: { // <revisionlist>
-                QString project;
-                QString package;
-                if (reply->property("prjrev").isValid()) {
-                    project = reply->property("prjrev").toString();
-                }
-                if (reply->property("pkgrev").isValid()) {
-                    package = reply->property("pkgrev").toString();
-                }
-                xmlReader->parseRevisionList(project, package, dataStr);
-                break;
-            }
-
-            case OBSCore::LatestRevision: { // <revision>
-                QString project;
-                QString package;
-                if (reply->property("prjrev").isValid()) {
-                    project = reply->property("prjrev").toString();
+    bool unhandledError = false;
+    foreach (const RequestInfo &info, infos) {
+        if (reply->error() == QNetworkReply::NoError) {
+            if (info.revalidate) {
+                emit dataRevalidated(reply->request().url().toString());
+                if (httpStatusCode == 304) {
+                    // The stale data which is already shown is up to date
+                    continue;
                 }
-                if (reply->property("pkgrev").isValid()) {
-                    package = reply->property("pkgrev").toString();
-                }
-                xmlReader->parseLatestRevision(project, package, dataStr);
-                break;
             }
-
-            case OBSCore::Link: { // <link>
-                xmlReader->parseLink(dataStr);
-                break;
-            }
-
-            case OBSCore::BuildStatus: // <status>
-                xmlReader->parseBuildStatus(dataStr);
-                break;
-
-            case OBSCore::BuildStatusList: // <resultlist>
-                xmlReader->parseResultList(dataStr);
-                break;
-
-            case OBSCore::IncomingRequests: // <collection>
-                xmlReader->parseIncomingRequests(dataStr);
-                break;
-
-            case OBSCore::OutgoingRequests: // <collection>
-                xmlReader->parseOutgoingRequests(dataStr);
-                break;
-
-            case OBSCore::DeclinedRequests: // <collection>
-                xmlReader->parseDeclinedRequests(dataStr);
-                break;
-
-            case OBSCore::ProjectRequests: {
-                QString project;
-                if (reply->property("prjreq").isValid()) {
-                    project = reply->property("prjreq").toString();
-                }
-                xmlReader->parseRequests(project, "", dataStr);
-                break;
-            }
-
-            case OBSCore::PackageRequests: {
-                QString project;
-                QString package;
-                if (reply->property("prjreq").isValid()) {
-                    project = reply->property("prjreq").toString();
-                }
-                if (reply->property("pkgreq").isValid()) {
-                    package = reply->property("pkgreq").toString();
-                }
-                xmlReader->parseRequests(project, package, dataStr);
-                break;
-            }
-
-            case OBSCore::ChangeRequestState:
-                xmlReader->parseRequestStatus(dataStr);
-                break;
-
-            case OBSCore::PackageSearch:
-                xmlReader->parsePackageSearch(dataStr);
-                break;
-
-            case OBSCore::SRDiff:
-                emit requestDiffFetched(dataStr);
-                break;
-
-            case OBSCore::BranchPackage: {
-                xmlReader->parseBranchPackage(dataStr);
-                break;
-            }
-
-            case OBSCore::LinkPackage: {
-                QString project;
-                QString package;
-                if (reply->property("destprj").isValid()) {
-                    project = reply->property("destprj").toString();
-                }
-                if (reply->property("destpkg").isValid()) {
-                    package = reply->property("destpkg").toString();
-                }
-                xmlReader->parseLinkPackage(project, package, dataStr);
-                break;
-            }
-
-            case OBSCore::CopyPackage: {
-                QString project;
-                QString package;
-                if (reply->property("destprj").isValid()) {
-                    project = reply->property("destprj").toString();
-                }
-                if (reply->property("destpkg").isValid()) {
-                    package = reply->property("destpkg").toString();
-                }
-                xmlReader->parseCopyPackage(project, package, dataStr);
-                break;
+            if (info.finished) {
+                info.finished(reply, streamed && info.received ? unreadData : data);
             }
+        } else if (!info.failed || !info.failed(reply, data)) {
+            unhandledError = true;
+        }
+    }
 
-            case OBSCore::CreateRequest: {
-                xmlReader->parseCreateRequest(dataStr);
-                break;
-            }
+    // Report the error once, even if the reply was shared
+    if (unhandledError) {
+        handleError(reply, data);
+    }
 
-            case OBSCore::CreateProject: {
-                QString project;
-                if (reply->property("createprj").isValid()) {
-                    project = reply->property("createprj").toString();
-                }
-                xmlReader->parseCreateProject(project, dataStr);
-                break;
-            }
+    reply->deleteLater();
+}
 
-            case OBSCore::CreatePackage: {
-                QString project;
-                QString package;
-                if (reply->property("createprj").isValid()) {
-                    project = reply->property("createprj").toString();
-                }
-                if (reply->property("createpkg").isValid()) {
-                    package = reply->property("createpkg").toString();
-                }
-                xmlReader->parseCreatePackage(project, package, dataStr);
-                break;
-            }
+void OBSCore::handleError(QNetworkReply *reply, const QByteArray &data)
+{
+    switch (reply->error()) {
 
-            case OBSCore::UploadFile: {
-                QString project;
-                QString package;
-                QString file;
-                if (reply->property("uploadprj").isValid()) {
-                    project = reply->property("uploadprj").toString();
-                }
-                if (reply->property("uploadpkg").isValid()) {
-                    package = reply->property("uploadpkg").toString();
-                }
-                if (reply->property("uploadfile").isValid()) {
-                    file = reply->property("uploadfile").toString();
-                }
-                xmlReader->parseUploadFile(project, package, file, dataStr);
-                break;
-            }
+    case QNetworkReply::ContentNotFoundError: // 404
+    case QNetworkReply::ProtocolInvalidOperationError: { // 400
+        qDebug() << Q_FUNC_INFO << "Request failed! Error:" << reply->errorString()
+                 << "data =" << data;
+        QSharedPointer<OBSStatus> status = xmlReader->parseError(data);
+        emit networkError(reply->errorString() + status->getSummary());
+        break;
+    }
 
-            case OBSCore::DownloadFile: {
-                QString fileName;
-                if (reply->property("downloadfile").isValid()) {
-                    fileName = reply->property("downloadfile").toString();
-                }
-                emit fileFetched(fileName, data);
-                break;
-            }
+    case QNetworkReply::ContentAccessDenied: // 401
+        qDebug() << Q_FUNC_INFO << "Access denied!";
+        break;
 
-            case OBSCore::BuildLog: {
-                emit buildLogFetched(dataStr);
-                break;
-            }
+    case QNetworkReply::OperationCanceledError:
+        qDebug() << Q_FUNC_INFO << "Request canceled:" << reply->url().toString();
+        break;
 
-            case OBSCore::DeleteProject: {
-                QString project;
-                if (reply->property("deleteprj").isValid()) {
-                    project = reply->property("deleteprj").toString();
-                }
-                xmlReader->parseDeleteProject(project, dataStr);
-                break;
-            }
+    case QNetworkReply::AuthenticationRequiredError:
+        qDebug() << Q_FUNC_INFO << "Credentials provided not accepted!";
+        break;
 
-            case OBSCore::DeletePackage: {
-                QString project;
-                QString package;
-                if (reply->property("deleteprj").isValid()) {
-                    project = reply->property("deleteprj").toString();
-                }
-                if (reply->property("deletepkg").isValid()) {
-                    package = reply->property("deletepkg").toString();
-                }
-                xmlReader->parseDeletePackage(project, package, dataStr);
-                break;
-            }
+    default: // Other errors
+        qDebug() << Q_FUNC_INFO << "Request failed! Error:" << reply->errorString();
+        qDebug() << data;
+        emit networkError(reply->errorString());
+        break;
+    }
+}
 
-            case OBSCore::DeleteFile: {
-                QString project;
-                QString package;
-                QString fileName;
-                if (reply->property("deleteprj").isValid()) {
-                    project = reply->property("deleteprj").toString();
-                }
-                if (reply->property("deletepkg").isValid()) {
-                    package = reply->property("deletepkg").toString();
-                }
-                if (reply->property("deletefile").isValid()) {
-                    fileName = reply->property("deletefile").toString();
-                }
-                xmlReader->parseDeleteFile(project, package, fileName, dataStr);
-                break;
-            }
+OBSCore::RequestInfo &OBSCore::setHandler(quint64 requestId, OBSCore::RequestType type,
+                                          const ReplyHandler &finished, const ErrorHandler &failed)
+{
+    scheduler->setPriority(requestId, getPriority(type));
 
-            case OBSCore::About:
-                xmlReader->parseAbout(dataStr);
-                break;
+    RequestInfo &info = pendingRequests[requestId];
+    info.type = type;
+    info.finished = finished;
+    info.failed = failed;
+    return info;
+}
 
-            case OBSCore::Person:
-                xmlReader->parsePerson(dataStr);
-                break;
+OBSCore::RequestInfo &OBSCore::setHandler(QNetworkReply *reply, OBSCore::RequestType type,
+                                          const ReplyHandler &finished, const ErrorHandler &failed)
+{
+    RequestInfo &info = *requests.insert(reply, RequestInfo());
+    info.type = type;
+    info.finished = finished;
+    info.failed = failed;
+    return info;
+}
 
-            case OBSCore::UpdatePerson:
-                xmlReader->parseUpdatePerson(dataStr);
-                break;
+OBSRequestScheduler::Priority OBSCore::getPriority(OBSCore::RequestType type)
+{
+    switch (type) {
+    case OBSCore::BuildStatus:
+    case OBSCore::BuildResults:
+    case OBSCore::IncomingRequests:
+    case OBSCore::OutgoingRequests:
+    case OBSCore::DeclinedRequests:
+    case OBSCore::About:
+    case OBSCore::Person:
+    case OBSCore::Distributions:
+        return OBSRequestScheduler::Background;
+    case OBSCore::UploadFile:
+    case OBSCore::DownloadFile:
+    case OBSCore::BuildLog:
+        return OBSRequestScheduler::Bulk;
+    default:
+        return OBSRequestScheduler::Interactive;
+    }
+}
 
-            case OBSCore::Distributions:
-                xmlReader->parseDistributions(dataStr);
-                break;
-            }
-            return;
+void OBSCore::onRequestStarted(quint64 requestId, QNetworkReply *reply)
+{
+    if (pendingRequests.contains(requestId)) {
+        RequestInfo info = pendingRequests.take(requestId);
+        requests.insert(reply, info);
+        if (info.started) {
+            info.started(reply);
         }
-        QString dataStr = QString::fromUtf8(data);
-        xmlReader->addData(dataStr);
-        break; // end of case QNetworkReply::NoError
+        if (info.received && !receivedData.contains(reply)) {
+            receivedData.insert(reply, QByteArray());
+            connect(reply, &QNetworkReply::readyRead, this, [this, reply]() {
+                receiveData(reply);
+            });
+            // Replies which are deleted without finishing (e.g. along with the manager)
+            connect(reply, &QObject::destroyed, this, [this, reply]() {
+                receivedData.remove(reply);
+            });
+        }
+    } else {
+        // Requests without a handler are parsed as generic data
+        RequestInfo info;
+        info.finished = [this](QNetworkReply *, const QByteArray &data) {
+            OBSParseContext context;
+            xmlReader->parseInBackground(&OBSXmlReader::addData, context, data);
+        };
+        requests.insert(reply, info);
     }
+}
 
-    case QNetworkReply::ContentNotFoundError: // 404
-        if (reply->property("reqtype").isValid()) {
-
-            switch(reply->property("reqtype").toInt()) {
-
-            case OBSCore::Login: // <hash><status>
-                qDebug() << Q_FUNC_INFO << "OBS API not found at" << reply->url().toString();
-                emit apiNotFound(reply->url());
-                break;
-
-            case OBSCore::PackageList: // <status>
-                if (isAuthenticated()) {
-                    QString dataStr = QString::fromUtf8(data);
-                    QSharedPointer<OBSStatus> status = xmlReader->parseNotFoundStatus(dataStr);
-                    qDebug() << Q_FUNC_INFO << "Project not found!" << status->getSummary() << status->getCode();
-                    emit projectNotFound(status);
-                }
-                break;
-
-            case OBSCore::FileList: // <status>
-            case OBSCore::RevisionList: // <status>
-            case OBSCore::LatestRevision: // <status>
-                if (isAuthenticated()) {
-                    QString dataStr = QString::fromUtf8(data);
-                    QSharedPointer<OBSStatus> status = xmlReader->parseNotFoundStatus(dataStr);
-                    qDebug() << Q_FUNC_INFO << "Package not found!" << status->getSummary() << status->getCode();
-                    emit packageNotFound(status);
-                }
-                break;
+void OBSCore::onRequestCanceled(quint64 requestId)
+{
+    pendingRequests.remove(requestId);
 
-            case OBSCore::BuildStatus: // <status>
-                if (isAuthenticated()) {
-                    QString dataStr = QString::fromUtf8(data);
-                    xmlReader->parseBuildStatus(dataStr);
-                }
-                break;
+    // The watch doesn't wait for a canceled project results request
+    QString resource = seedingResults.key(requestId);
+    if (!resource.isEmpty()) {
+        seedingResults.remove(resource);
+        requestWatchedResults(resource);
+    }
+}
 
-            case OBSCore::CreateRequest:
-                xmlReader->parseCreateRequestStatus(data);
-                break;
+int OBSCore::createCancellationToken()
+{
+    return ++lastCancellationToken;
+}
 
-            case OBSCore::LinkPackage: {
-                QString project;
-                QString package;
-                if (reply->property("destprj").isValid()) {
-                    project = reply->property("destprj").toString();
-                }
-                if (reply->property("destpkg").isValid()) {
-                    package = reply->property("destpkg").toString();
-                }
-                QSharedPointer<OBSStatus> status = QSharedPointer<OBSStatus>(new OBSStatus());
-                QString details = QString("The package %2 in project %1 does NOT exist.").arg(project, package);
-                status->setDetails(details);
-                status->setSummary("Cannot link");
-                status->setCode("error");
-                status->setProject(project);
-                status->setPackage(package);
-
-                emit cannotLinkPackage(status);
-                break;
-            }
+void OBSCore::setCancellationToken(int token)
+{
+    cancellationToken = token;
+}
 
-            case OBSCore::BuildLog: {
-                emit buildLogNotFound();
-                break;
-            }
+void OBSCore::cancelRequests(int token)
+{
+    qDebug() << Q_FUNC_INFO << token;
+    scheduler->cancel(token);
+}
 
-            default:
-                qDebug() << Q_FUNC_INFO << "Error 404: " << reply->errorString()
-                                        << "data =" << data;
-                QSharedPointer<OBSStatus> status = xmlReader->parseError(data);
-                emit networkError(reply->errorString() + status->getSummary());
-            }
-        }
-        break;
+OBSCore::ReplyHandler OBSCore::parseWith(void (OBSXmlReader::*parser)(const QByteArray &))
+{
+    return [this, parser](QNetworkReply *, const QByteArray &data) {
+        xmlReader->parseInBackground(parser, data);
+    };
+}
 
-    case QNetworkReply::ProtocolInvalidOperationError: // 400
-        if (reply->property("reqtype").isValid()) {
+OBSCore::RequestInfo &OBSCore::setStreamHandler(quint64 requestId, OBSCore::RequestType type,
+                                                OBSXmlStream::Parser parser, const OBSParseContext &context,
+                                                const ErrorHandler &failed)
+{
+    QSharedPointer<OBSXmlStream> stream(new OBSXmlStream());
+    stream->parser = parser;
+    stream->context = context;
+
+    RequestInfo &info = setHandler(requestId, type, [this, stream](QNetworkReply *, const QByteArray &data) {
+        xmlReader->parseStream(stream, data, true);
+    }, [this, stream, failed](QNetworkReply *reply, const QByteArray &data) {
+        // Receivers wait for the end of the stream, also when the reply fails
+        xmlReader->abortStream(stream);
+        return failed && failed(reply, data);
+    });
+    info.received = [this, stream](QNetworkReply *, const QByteArray &data) {
+        xmlReader->parseStream(stream, data, false);
+    };
+    return info;
+}
 
-            switch(reply->property("reqtype").toInt()) {
-            case OBSCore::CreateRequest:
-                xmlReader->parseCreateRequestStatus(data);
-                break;
-            case OBSCore::BranchPackage: {
-                xmlReader->parseBranchPackage(data);
-                break;
-            }
-            default:
-                qDebug() << Q_FUNC_INFO << "Request failed! Error:" << reply->errorString()
-                         << "data =" << data;
-                QSharedPointer<OBSStatus> status = xmlReader->parseError(data);
-                emit networkError(reply->errorString() + status->getSummary());
+void OBSCore::setBuildStatusHandler(quint64 requestId, int row)
+{
+    OBSParseContext context;
+    context.row = row;
+
+    setHandler(requestId, OBSCore::BuildStatus, [this, context](QNetworkReply *, const QByteArray &data) {
+        xmlReader->parseInBackground(&OBSXmlReader::parseBuildStatus, context, data);
+    }, [this, context](QNetworkReply *reply, const QByteArray &data) {
+        // Set package row always (error/no error). Needed for inserting the build status
+        if (reply->error() == QNetworkReply::ContentNotFoundError) {
+            if (isAuthenticated()) {
+                xmlReader->parseInBackground(&OBSXmlReader::parseBuildStatus, context, data);
             }
-
+            return true;
         }
-        break;
-
-    case QNetworkReply::ContentAccessDenied: // 401
-        qDebug() << Q_FUNC_INFO << "Access denied!";
-        if (reply->property("reqtype").isValid()) {
-            QSharedPointer<OBSStatus> status = QSharedPointer<OBSStatus>();
-            switch(reply->property("reqtype").toInt()) {
-
-            case OBSCore::CopyPackage: {
-                status = QSharedPointer<OBSStatus>(new OBSStatus());
-                QString project;
-                QString package;
-                if (reply->property("destprj").isValid()) {
-                    project = reply->property("destprj").toString();
-                }
-                if (reply->property("destpkg").isValid()) {
-                    package = reply->property("destpkg").toString();
-                }
-                status->setProject(project);
-                status->setPackage(package);
-                status->setCode("error");
-                status->setSummary("Cannot copy");
-                status->setDetails(tr("You don't have the appropriate permissions to<br>copy %1 to %2<br>")
-                                      .arg(status->getPackage(), status->getProject()));
-                emit cannotCopyPackage(status);
-                break;
-            }
-            case OBSCore::CreateProject: {
-                status = QSharedPointer<OBSStatus>(new OBSStatus());
-                QString project;
-                if (reply->property("createprj").isValid()) {
-                    project = reply->property("createprj").toString();
-                }
-                status->setProject(project);
-                status->setCode("error");
-                status->setSummary("Cannot create");
-                status->setDetails(tr("You don't have the appropriate permissions to create<br>%1")
-                                      .arg(status->getProject()));
-                emit cannotCreateProject(status);
-                break;
-            }
-
-            case OBSCore::CreatePackage: {
-                status = QSharedPointer<OBSStatus>(new OBSStatus());
-                QString project;
-                QString package;
-                if (reply->property("createprj").isValid()) {
-                    project = reply->property("createprj").toString();
-                }
-                if (reply->property("createpkg").isValid()) {
-                    package = reply->property("createpkg").toString();
-                }
-                status->setProject(project);
-                status->setPackage(package);
-                status->setCode("error");
-                status->setSummary("Cannot create");
-                status->setDetails(tr("You don't have the appropriate permissions to create<br>%1/%2")
-                                      .arg(status->getProject(), status->getPackage()));
-                emit cannotCreatePackage(status);
-                break;
-            }
-
-            case OBSCore::UploadFile: {
-                status = QSharedPointer<OBSStatus>(new OBSStatus());
-                QString project;
-                QString package;
-                if (reply->property("uploadprj").isValid()) {
-                    project = reply->property("uploadprj").toString();
-                }
-                if (reply->property("uploadpkg").isValid()) {
-                    package = reply->property("uploadpkg").toString();
-                }
-                status->setProject(project);
-                status->setPackage(package);
-                status->setCode("error");
-                status->setSummary("Cannot upload file");
-                status->setDetails(tr("You don't have the appropriate permissions to upload to <br>%1/%2")
-                                      .arg(status->getProject(), status->getPackage()));
-                emit cannotUploadFile(status);
-                break;
-            }
-
-            case OBSCore::DeleteProject: {
-                status = QSharedPointer<OBSStatus>(new OBSStatus());
-                QString project;
-                if (reply->property("deleteprj").isValid()) {
-                    project = reply->property("deleteprj").toString();
-                }
-                status->setProject(project);
-                status->setCode("error");
-                status->setSummary("Cannot delete");
-                status->setDetails(tr("You don't have the appropriate permissions to delete<br>%1")
-                                      .arg(status->getProject()));
-                emit cannotDeleteProject(status);
-                break;
-            }
-
-            case OBSCore::DeletePackage: {
-                status = QSharedPointer<OBSStatus>(new OBSStatus());
-                QString project;
-                QString package;
-                if (reply->property("deleteprj").isValid()) {
-                    project = reply->property("deleteprj").toString();
-                }
-                if (reply->property("deletepkg").isValid()) {
-                    package = reply->property("deletepkg").toString();
-                }
-                status->setProject(project);
-                status->setPackage(package);
-                status->setCode("error");
-                status->setSummary("Cannot delete");
-                status->setDetails(tr("You don't have the appropriate permissions to delete<br>%1/%2")
-                                      .arg(status->getProject(), status->getPackage()));
-                emit cannotDeletePackage(status);
-                break;
-            }
+        return false;
+    });
+}
 
-            case OBSCore::DeleteFile: {
-                status = QSharedPointer<OBSStatus>(new OBSStatus());
-                QString project;
-                QString package;
-                QString fileName;
-                if (reply->property("deleteprj").isValid()) {
-                    project = reply->property("deleteprj").toString();
-                }
-                if (reply->property("deletepkg").isValid()) {
-                    package = reply->property("deletepkg").toString();
-                }
-                if (reply->property("deletefile").isValid()) {
-                    fileName = reply->property("deletefile").toString();
-                }
-                status->setProject(project);
-                status->setPackage(package);
-                status->setCode("error");
-                status->setSummary("Cannot delete");
-                status->setDetails(tr("You don't have the appropriate permissions to delete<br>%1/%2/%3")
-                                      .arg(status->getProject(), status->getPackage(), fileName));
-                emit cannotDeleteFile(status);
-                break;
-            }
+QSharedPointer<OBSStatus> OBSCore::createErrorStatus(const QString &project, const QString &package,
+                                                     const QString &summary, const QString &details)
+{
+    QSharedPointer<OBSStatus> status(new OBSStatus());
+    status->setProject(project);
+    status->setPackage(package);
+    status->setCode("error");
+    status->setSummary(summary);
+    status->setDetails(details);
+    return status;
+}
 
+OBSCore::ErrorHandler OBSCore::packageNotFoundHandler()
+{
+    return [this](QNetworkReply *reply, const QByteArray &data) {
+        if (reply->error() == QNetworkReply::ContentNotFoundError) {
+            if (isAuthenticated()) {
+                QSharedPointer<OBSStatus> status = xmlReader->parseNotFoundStatus(data);
+                qDebug() << Q_FUNC_INFO << "Package not found!" << status->getSummary() << status->getCode();
+                emit packageNotFound(status);
             }
+            return true;
         }
-        break;
-
-    case QNetworkReply::AuthenticationRequiredError:
-        qDebug() << Q_FUNC_INFO << "Credentials provided not accepted!";
-        break;
-
-    default: // Other errors
-        qDebug() << Q_FUNC_INFO << "Request failed! Error:" << reply->errorString();
-        qDebug() << data;
-        emit networkError(reply->errorString());
-        break;
-    }
-
-    reply->deleteLater();
+        return false;
+    };
 }
 
 void OBSCore::getRequestDiff(const QString &resource)
 {
-    QNetworkReply *reply = postRequest(resource, "", "application/x-www-form-urlencoded");
-    reply->setProperty("reqtype", OBSCore::SRDiff);
+    quint64 requestId = postRequest(resource, "", "application/x-www-form-urlencoded");
+    setHandler(requestId, OBSCore::SRDiff, [this](QNetworkReply *, const QByteArray &data) {
+        emit requestDiffFetched(QString::fromUtf8(data));
+    });
 }
 
 void OBSCore::branchPackage(const QString &project, const QString &package)
 {
     QString resource = QString("/source/%1/%2?cmd=branch").arg(project, package);
-    QNetworkReply *reply = postRequest(resource, "", "application/x-www-form-urlencoded");
-    reply->setProperty("reqtype", OBSCore::BranchPackage);
+    quint64 requestId = postRequest(resource, "", "application/x-www-form-urlencoded");
+    setHandler(requestId, OBSCore::BranchPackage, parseWith(&OBSXmlReader::parseBranchPackage),
+               [this](QNetworkReply *reply, const QByteArray &data) {
+        if (reply->error() == QNetworkReply::ProtocolInvalidOperationError) {
+            xmlReader->parseBranchPackage(data);
+            return true;
+        }
+        return false;
+    });
 }
 
 void OBSCore::linkPackage(const QString &srcProject, const QString &srcPackage, const QString &dstProject)
@@ -982,116 +1070,387 @@ void OBSCore::copyPackage(const QString &originProject, const QString &originPac
 {
     QString resource = QString("/source/%1/%2?cmd=copy&oproject=%3&opackage=%4&comment=%5")
             .arg(destProject, destPackage, originProject, originPackage, comments);
-    QNetworkReply *reply = postRequest(resource, "", "application/x-www-form-urlencoded");
-    reply->setProperty("reqtype", OBSCore::CopyPackage);
-    reply->setProperty("destprj", destProject);
-    reply->setProperty("destpkg", destPackage);
+    quint64 requestId = postRequest(resource, "", "application/x-www-form-urlencoded");
+    setHandler(requestId, OBSCore::CopyPackage, [this, destProject, destPackage](QNetworkReply *, const QByteArray &data) {
+        xmlReader->parseInBackground(&OBSXmlReader::parseCopyPackage, destProject, destPackage, data);
+    }, [this, destProject, destPackage](QNetworkReply *reply, const QByteArray &) {
+        if (reply->error() == QNetworkReply::ContentAccessDenied) {
+            QString details = tr("You don't have the appropriate permissions to<br>copy %1 to %2<br>")
+                    .arg(destPackage, destProject);
+            emit cannotCopyPackage(createErrorStatus(destProject, destPackage, "Cannot copy", details));
+        }
+        return false;
+    });
 }
 
 void OBSCore::createRequest(const QByteArray &data)
 {
     QString resource = QString("/request?cmd=create");
-    QNetworkReply *reply = postRequest(resource, data, "application/xml");
-    reply->setProperty("reqtype", OBSCore::CreateRequest);
+    quint64 requestId = postRequest(resource, data, "application/xml");
+    setHandler(requestId, OBSCore::CreateRequest, parseWith(&OBSXmlReader::parseCreateRequest),
+               [this](QNetworkReply *reply, const QByteArray &data) {
+        if (reply->error() == QNetworkReply::ContentNotFoundError ||
+                reply->error() == QNetworkReply::ProtocolInvalidOperationError) {
+            xmlReader->parseCreateRequestStatus(data);
+            return true;
+        }
+        return false;
+    });
 }
 
 void OBSCore::createProject(const QString &project, const QByteArray &data)
 {
     QString resource = QString("/source/%1/_meta").arg(project);
-    QNetworkReply *reply = putRequest(resource, data);
-    reply->setProperty("reqtype", OBSCore::CreateProject);
-    reply->setProperty("createprj", project);
+    quint64 requestId = putRequest(resource, data);
+    setHandler(requestId, OBSCore::CreateProject, [this, project](QNetworkReply *, const QByteArray &data) {
+        xmlReader->parseInBackground(&OBSXmlReader::parseCreateProject, project, data);
+    }, [this, project](QNetworkReply *reply, const QByteArray &) {
+        if (reply->error() == QNetworkReply::ContentAccessDenied) {
+            QString details = tr("You don't have the appropriate permissions to create<br>%1").arg(project);
+            emit cannotCreateProject(createErrorStatus(project, "", "Cannot create", details));
+        }
+        return false;
+    });
 }
 
 void OBSCore::createPackage(const QString &project, const QString &package, const QByteArray &data)
 {
     QString resource = QString("/source/%1/%2/_meta").arg(project, package);
-    QNetworkReply *reply = putRequest(resource, data);
-    reply->setProperty("reqtype", OBSCore::CreatePackage);
-    reply->setProperty("createprj", project);
-    reply->setProperty("createpkg", package);
+    quint64 requestId = putRequest(resource, data);
+    setHandler(requestId, OBSCore::CreatePackage, [this, project, package](QNetworkReply *, const QByteArray &data) {
+        xmlReader->parseInBackground(&OBSXmlReader::parseCreatePackage, project, package, data);
+    }, [this, project, package](QNetworkReply *reply, const QByteArray &) {
+        if (reply->error() == QNetworkReply::ContentAccessDenied) {
+            QString details = tr("You don't have the appropriate permissions to create<br>%1/%2")
+                    .arg(project, package);
+            emit cannotCreatePackage(createErrorStatus(project, package, "Cannot create", details));
+        }
+        return false;
+    });
 }
 
-void OBSCore::uploadFile(const QString &project, const QString &package, const QString &fileName, const QByteArray &data)
+int OBSCore::uploadFile(const QString &project, const QString &package, const QString &fileName, const QString &path)
 {
+    QFile *file = new QFile(path);
+    if (!file->open(QIODevice::ReadOnly)) {
+        emit cannotUploadFile(createErrorStatus(project, package, "Cannot upload file", file->errorString()));
+        delete file;
+        return 0;
+    }
+
+// The file is streamed from disk; each upload gets its own token so that it can be canceled
     QString resource = QString("/source/%1/%2/%3").arg(project, package, fileName);
-    QNetworkReply *reply = putRequest(resource, data);
-    reply->setProperty("reqtype", OBSCore::UploadFile);
-    reply->setProperty("uploadprj", project);
-    reply->setProperty("uploadpkg", package);
-    reply->setProperty("uploadfile", fileName);
+    QNetworkRequest request;
+    request.setUrl(QUrl(apiUrl + resource));
+    request.setRawHeader("User-Agent", userAgent.toLatin1());
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/octet-stream");
+    request.setHeader(QNetworkRequest::ContentLengthHeader, file->size());
+
+    int token = createCancellationToken();
+    quint64 requestId = scheduler->enqueue(QNetworkAccessManager::PutOperation, request, file, token);
+    RequestInfo &info = setHandler(requestId, OBSCore::UploadFile, [this, project, package, fileName](QNetworkReply *, const QByteArray &data) {
+        xmlReader->parseInBackground(&OBSXmlReader::parseUploadFile, project, package, fileName, data);
+    }, [this, project, package](QNetworkReply *reply, const QByteArray &) {
+        if (reply->error() == QNetworkReply::ContentAccessDenied) {
+            QString details = tr("You don't have the appropriate permissions to upload to <br>%1/%2")
+                    .arg(project, package);
+            emit cannotUploadFile(createErrorStatus(project, package, "Cannot upload file", details));
+        }
+        return false;
+    });
+    info.started = [this, token, fileName](QNetworkReply *reply) {
+        connect(reply, &QNetworkReply::uploadProgress, this, [this, token, fileName](qint64 bytesSent, qint64 bytesTotal) {
+            emit uploadProgress(token, fileName, bytesSent, bytesTotal);
+        });
+    };
+
+    return token;
 }
 
-void OBSCore::downloadFile(const QString &project, const QString &package, const QString &fileName)
+void OBSCore::downloadFile(const QString &project, const QString &package, const QString &fileName,
+                           const QString &path)
 {
     QString resource = QString("/source/%1/%2/%3").arg(project, package, fileName);
-    QNetworkReply *reply = request(resource);
-    reply->setProperty("reqtype", OBSCore::DownloadFile);
-    reply->setProperty("downloadprj", project);
-    reply->setProperty("downloadpkg", package);
-    reply->setProperty("downloadfile", fileName);
+    QNetworkRequest request = createGetRequest(resource);
+    request.setAttribute(OBSRequestScheduler::ExclusiveAttribute, true);
+
+// The body is written to <path>.part, which is renamed when complete.
+// A .part left by an interrupted download is resumed with a Range request
+    QSharedPointer<FileDownload> download(new FileDownload);
+    download->fileName = fileName;
+    download->file.setFileName(path + ".part");
+    download->offset = download->file.exists() ? download->file.size() : 0;
+    if (download->offset > 0) {
+        qDebug() << Q_FUNC_INFO << "Resuming" << fileName << "at" << download->offset;
+        request.setRawHeader("Range", "bytes=" + QByteArray::number(download->offset) + "-");
+    }
+
+    quint64 requestId = scheduler->enqueue(QNetworkAccessManager::GetOperation, request,
+                                           QByteArray(), cancellationToken);
+    RequestInfo &info = setHandler(requestId, OBSCore::DownloadFile,
+                                   [this, download, path](QNetworkReply *reply, const QByteArray &data) {
+        writeDownload(reply, download, data);
+        download->file.close();
+        if (!download->error.isEmpty()) {
+            emit networkError(download->error);
+            return;
+        }
+        QFile::remove(path);
+        if (!download->file.rename(path)) {
+            emit networkError(tr("Cannot rename %1 to %2: %3").arg(download->file.fileName(), path,
+                                                                   download->file.errorString()));
+            return;
+        }
+        emit fileDownloaded(download->fileName, path);
+    }, [this, download, project, package, path](QNetworkReply *reply, const QByteArray &) {
+        download->file.close();
+        if (!download->error.isEmpty()) {
+            emit networkError(download->error);
+            return true;
+        }
+        // The .part is kept for resuming, unless the server rejected its range
+        int httpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (httpStatusCode == 416) {
+            download->file.remove();
+            downloadFile(project, package, download->fileName, path);
+            return true;
+        }
+        return false;
+    });
+    info.started = [this, download](QNetworkReply *reply) {
+        reply->setReadBufferSize(downloadBufferSize);
+        connect(reply, &QNetworkReply::readyRead, this, [this, reply, download]() {
+            writeDownload(reply, download, QByteArray());
+        });
+        connect(reply, &QNetworkReply::downloadProgress, this, [this, download](qint64 bytesReceived, qint64 bytesTotal) {
+            emit downloadProgress(download->fileName, download->offset + bytesReceived,
+                                  bytesTotal < 0 ? -1 : download->offset + bytesTotal);
+        });
+    };
+}
+
+void OBSCore::writeDownload(QNetworkReply *reply, QSharedPointer<FileDownload> download, const QByteArray &data)
+{
+    // Error bodies are left in the reply, to be handled by replyFinished()
+    int httpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (!download->error.isEmpty() || (httpStatusCode != 200 && httpStatusCode != 206)) {
+        return;
+    }
+
+    if (!download->file.isOpen()) {
+        // 200 means the server ignored the range, start over
+        QIODevice::OpenMode mode = QIODevice::WriteOnly;
+        if (httpStatusCode == 206) {
+            mode |= QIODevice::Append;
+        } else {
+            download->offset = 0;
+        }
+        if (!download->file.open(mode)) {
+            download->error = tr("Cannot open %1: %2").arg(download->file.fileName(), download->file.errorString());
+            reply->abort();
+            return;
+        }
+    }
+
+    QByteArray chunk = data.isEmpty() ? reply->readAll() : data;
+    if (!chunk.isEmpty() && download->file.write(chunk) != chunk.size()) {
+        download->error = tr("Cannot write %1: %2").arg(download->file.fileName(), download->file.errorString());
+        reply->abort();
+    }
+}
+
+void OBSCore::receiveData(QNetworkReply *reply)
+{
+    // Error bodies are left in the reply, to be handled by replyFinished()
+    int httpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (httpStatusCode != 200) {
+        return;
+    }
+
+    QByteArray data = reply->readAll();
+    bool keepData = false;
+    foreach (const RequestInfo &info, requests.values(reply)) {
+        if (info.received) {
+            info.received(reply, data);
+        }
+        // The reply cache and handlers which don't stream need the whole body
+        if (info.conditional || !info.received) {
+            keepData = true;
+        }
+    }
+    if (keepData) {
+        receivedData[reply].append(data);
+    }
 }
 
 void OBSCore::getBuildLog(const QString &project, const QString &repository, const QString &arch, const QString &package)
 {
     QString resource = QString("/build/%1/%2/%3/%4/_log").arg(project, repository, arch, package);
-    QNetworkReply *reply = request(resource);
-    reply->setProperty("reqtype", OBSCore::BuildLog);
+    quint64 requestId = request(resource);
+    setHandler(requestId, OBSCore::BuildLog, [this](QNetworkReply *, const QByteArray &data) {
+        emit buildLogFetched(QString::fromUtf8(data));
+    }, [this](QNetworkReply *reply, const QByteArray &) {
+        if (reply->error() == QNetworkReply::ContentNotFoundError) {
+            emit buildLogNotFound();
+            return true;
+        }
+        return false;
+    });
+}
+
+void OBSCore::getBuildLogTail(const QString &project, const QString &repository, const QString &arch,
+                              const QString &package, qint64 offset)
+{
+// Only the bytes after offset are fetched; nostream returns what there is
+// so far instead of keeping the connection open until the build ends
+    QString build = QString("%1/%2/%3/%4").arg(project, repository, arch, package);
+    QString resource = QString("/build/%1/_log?nostream=1&start=%2").arg(build).arg(offset);
+    QNetworkRequest request = createGetRequest(resource);
+    request.setAttribute(OBSRequestScheduler::ExclusiveAttribute, true);
+
+    quint64 requestId = scheduler->enqueue(QNetworkAccessManager::GetOperation, request,
+                                           QByteArray(), cancellationToken);
+    RequestInfo &info = setHandler(requestId, OBSCore::BuildLog, [this, build](QNetworkReply *, const QByteArray &data) {
+        if (!data.isEmpty()) {
+            emit buildLogAppended(build, data);
+        }
+        emit buildLogTailFinished(build, true);
+    }, [this, build, offset](QNetworkReply *reply, const QByteArray &) {
+        if (reply->error() == QNetworkReply::ContentNotFoundError && offset == 0) {
+            emit buildLogNotFound();
+        }
+        emit buildLogTailFinished(build, false);
+        return true;
+    });
+    info.started = [this, build](QNetworkReply *reply) {
+        reply->setReadBufferSize(downloadBufferSize);
+        connect(reply, &QNetworkReply::readyRead, this, [this, reply, build]() {
+            int httpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            if (httpStatusCode == 200) {
+                emit buildLogAppended(build, reply->readAll());
+            }
+        });
+    };
+}
+
+void OBSCore::getBuildLogStatus(const QString &project, const QString &repository, const QString &arch,
+                                const QString &package)
+{
+    QString build = QString("%1/%2/%3/%4").arg(project, repository, arch, package);
+    quint64 requestId = requestBuild(build + "/_status");
+    setHandler(requestId, OBSCore::BuildStatus, [this, build](QNetworkReply *, const QByteArray &data) {
+        QSharedPointer<OBSStatus> status = xmlReader->parseStatus(data);
+        emit buildLogStatusFetched(build, status->getCode());
+    }, [this, build](QNetworkReply *, const QByteArray &) {
+        emit buildLogStatusFetched(build, QString());
+        return true;
+    });
+}
+
+// The last job of a build tells whether a log is the one of an archived build
+void OBSCore::getBuildJob(const QString &project, const QString &repository, const QString &arch,
+                          const QString &package)
+{
+    QString build = QString("%1/%2/%3/%4").arg(project, repository, arch, package);
+    quint64 requestId = requestBuild(QString("%1/%2/%3/_jobhistory?package=%4&limit=1")
+                                     .arg(project, repository, arch, QString(QUrl::toPercentEncoding(package))));
+    setHandler(requestId, OBSCore::BuildLog, [this, build](QNetworkReply *, const QByteArray &data) {
+        emit buildJobFetched(build, xmlReader->parseBuildJob(data));
+    }, [this, build](QNetworkReply *, const QByteArray &) {
+        emit buildJobFetched(build, QString());
+        return true;
+    });
+}
+
+void OBSCore::getLastSucceededBuildLog(const QString &project, const QString &repository, const QString &arch,
+                                       const QString &package)
+{
+    QString build = QString("%1/%2/%3/%4").arg(project, repository, arch, package);
+    quint64 requestId = requestBuild(build + "/_log?nostream=1&lastsucceeded=1");
+    setHandler(requestId, OBSCore::BuildLog, [this, build](QNetworkReply *, const QByteArray &data) {
+        emit lastSucceededBuildLogFetched(build, data);
+    }, [this, build](QNetworkReply *reply, const QByteArray &) {
+        if (reply->error() == QNetworkReply::ContentNotFoundError) {
+            emit lastSucceededBuildLogNotFound(build);
+            return true;
+        }
+        return false;
+    });
 }
 
 void OBSCore::deleteProject(const QString &project)
 {
     QString resource = QString("/source/%1").arg(project);
-    QNetworkReply *reply = deleteRequest(resource);
-    reply->setProperty("reqtype", OBSCore::DeleteProject);
-    reply->setProperty("deleteprj", project);
+    quint64 requestId = deleteRequest(resource);
+    setHandler(requestId, OBSCore::DeleteProject, [this, project](QNetworkReply *, const QByteArray &data) {
+        xmlReader->parseInBackground(&OBSXmlReader::parseDeleteProject, project, data);
+    }, [this, project](QNetworkReply *reply, const QByteArray &) {
+        if (reply->error() == QNetworkReply::ContentAccessDenied) {
+            QString details = tr("You don't have the appropriate permissions to delete<br>%1").arg(project);
+            emit cannotDeleteProject(createErrorStatus(project, "", "Cannot delete", details));
+        }
+        return false;
+    });
 }
 
 void OBSCore::deletePackage(const QString &project, const QString &package)
 {
     QString resource = QString("/source/%1/%2").arg(project, package);
-    QNetworkReply *reply = deleteRequest(resource);
-    reply->setProperty("reqtype", OBSCore::DeletePackage);
-    reply->setProperty("deleteprj", project);
-    reply->setProperty("deletepkg", package);
+    quint64 requestId = deleteRequest(resource);
+    setHandler(requestId, OBSCore::DeletePackage, [this, project, package](QNetworkReply *, const QByteArray &data) {
+        xmlReader->parseInBackground(&OBSXmlReader::parseDeletePackage, project, package, data);
+    }, [this, project, package](QNetworkReply *reply, const QByteArray &) {
+        if (reply->error() == QNetworkReply::ContentAccessDenied) {
+            QString details = tr("You don't have the appropriate permissions to delete<br>%1/%2")
+                    .arg(project, package);
+            emit cannotDeletePackage(createErrorStatus(project, package, "Cannot delete", details));
+        }
+        return false;
+    });
 }
 
 void OBSCore::deleteFile(const QString &project, const QString &package, const QString &fileName)
 {
     QString resource = QString("/source/%1/%2/%3").arg(project, package, fileName);
-    QNetworkReply *reply = deleteRequest(resource);
-    reply->setProperty("reqtype", OBSCore::DeleteFile);
-    reply->setProperty("deleteprj", project);
-    reply->setProperty("deletepkg", package);
-    reply->setProperty("deletefile", fileName);
+    quint64 requestId = deleteRequest(resource);
+    setHandler(requestId, OBSCore::DeleteFile, [this, project, package, fileName](QNetworkReply *, const QByteArray &data) {
+        xmlReader->parseInBackground(&OBSXmlReader::parseDeleteFile, project, package, fileName, data);
+    }, [this, project, package, fileName](QNetworkReply *reply, const QByteArray &) {
+        if (reply->error() == QNetworkReply::ContentAccessDenied) {
+            QString details = tr("You don't have the appropriate permissions to delete<br>%1/%2/%3")
+                    .arg(project, package, fileName);
+            emit cannotDeleteFile(createErrorStatus(project, package, "Cannot delete", details));
+        }
+        return false;
+    });
 }
 
 void OBSCore::about()
 {
     QString resource = "/about";
-    QNetworkReply *reply = request(resource);
-    reply->setProperty("reqtype", OBSCore::About);
+    quint64 requestId = request(resource);
+    setHandler(requestId, OBSCore::About, parseWith(&OBSXmlReader::parseAbout));
 }
 
 void OBSCore::getPerson()
 {
     QString resource = "/person/" + username;
-    QNetworkReply *reply = request(resource);
-    reply->setProperty("reqtype", OBSCore::Person);
+    quint64 requestId = request(resource);
+    setHandler(requestId, OBSCore::Person, parseWith(&OBSXmlReader::parsePerson));
 }
 
 void OBSCore::updatePerson(const QByteArray &data)
 {
     QString resource = "/person/" + username;
-    QNetworkReply *reply = putRequest(resource, data);
-    reply->setProperty("reqtype", OBSCore::UpdatePerson);
+    quint64 requestId = putRequest(resource, data);
+    setHandler(requestId, OBSCore::UpdatePerson, parseWith(&OBSXmlReader::parseUpdatePerson));
 }
 
 void OBSCore::getDistributions()
 {
     QString resource = "/distributions";
-    QNetworkReply *reply = request(resource);
-    reply->setProperty("reqtype", OBSCore::Distributions);
+    quint64 requestId = conditionalRequest(resource);
+    setHandler(requestId, OBSCore::Distributions, parseWith(&OBSXmlReader::parseDistributions));
 }
 
 void OBSCore::onSslErrors(QNetworkReply *reply, const QList<QSslError> &list)
@@ -1117,5 +1476,5 @@ void OBSCore::onSslErrors(QNetworkReply *reply, const QList<QSslError> &list)
         message=QString::number(list.count())+tr(" SSL errors have occured: %1");
     }
 
-   qDebug() << Q_FUNC_INFO << "url:" << reply->url() << "row:" << reply->property("row").toInt();
+   qDebug() << Q_FUNC_INFO << "url:" << reply->url();
 }
@@ -24,8 +24,16 @@
 #include <QSslError>
 #include <QDebug>
 #include <QEventLoop>
+#include <QHash>
+#include <QCache>
+#include <QDateTime>
+#include <QFile>
+#include <QThreadPool>
+#include <functional>
 #include "obsxmlreader.h"
 #include "obslinkhelper.h"
+#include "obsdiskcache.h"
+#include "obsrequestscheduler.h"
 
 class OBSCore : public QObject
 {
@@ -39,20 +47,31 @@ public:
     QString getApiUrl() const;
     void login();
     void logout();
-    QNetworkReply *request(const QString &resource);
+    int createCancellationToken();
+    void setCancellationToken(int token);
+    void cancelRequests(int token);
+    quint64 request(const QString &resource);
+    quint64 conditionalRequest(const QString &resource);
     void request(QNetworkReply *reply);
-    QNetworkReply *requestBuild(const QString &resource);
+    quint64 requestBuild(const QString &resource);
     void getBuildStatus(const QStringList &build, int row);
-    QNetworkReply *requestSource(const QString &resource);
-    QNetworkReply *requestRequest(const QString &resource);
+    void getBuildResults(const QString &project, const QStringList &packages,
+                         const QStringList &repositories, const QStringList &archs);
+    static QString createResultsResourceStr(const QString &project, const QStringList &packages,
+                                            const QStringList &repositories, const QStringList &archs);
+    void watchResults(const QString &project, const QString &resource);
+    void unwatchResults(const QString &resource);
+    void unwatchAllResults();
+    quint64 requestSource(const QString &resource);
+    quint64 requestRequest(const QString &resource);
     void getIncomingRequests();
     void getOutgoingRequests();
     void getDeclinedRequests();
     void getProjectRequests(const QString &project);
     void getPackageRequests(const QString &project, const QString &package);
-    QNetworkReply *postRequest(const QString &resource, const QByteArray &data, const QString &contentTypeHeader);
-    QNetworkReply *putRequest(const QString &resource, const QByteArray &data);
-    QNetworkReply *deleteRequest(const QString &resource);
+    quint64 postRequest(const QString &resource, const QByteArray &data, const QString &contentTypeHeader);
+    quint64 putRequest(const QString &resource, const QByteArray &data);
+    quint64 deleteRequest(const QString &resource);
     bool isIncludeHomeProjects() const;
     void setIncludeHomeProjects(bool value);
     void getProjects();
@@ -64,6 +83,7 @@ public:
     void getLatestRevision(const QString &project, const QString &package);
     void getLink(const QString &project, const QString &package);
     void getResults(const QString &resource);
+    void getProjectResults(const QString &project);
     void changeSubmitRequest(const QString &resource, const QByteArray &data);
     void packageSearch(const QString &package);
     void request(const QString &resource, int row);
@@ -75,9 +95,18 @@ public:
     void createRequest(const QByteArray &data);
     void createProject(const QString &project, const QByteArray &data);
     void createPackage(const QString &project, const QString &package, const QByteArray &data);
-    void uploadFile(const QString &project, const QString &package, const QString &fileName, const QByteArray &data);
-    void downloadFile(const QString &project, const QString &package, const QString &fileName);
+    int uploadFile(const QString &project, const QString &package, const QString &fileName, const QString &path);
+    void downloadFile(const QString &project, const QString &package, const QString &fileName,
+                      const QString &path);
     void getBuildLog(const QString &project, const QString &repository, const QString &arch, const QString &package);
+    void getBuildLogTail(const QString &project, const QString &repository, const QString &arch,
+                         const QString &package, qint64 offset);
+    void getBuildLogStatus(const QString &project, const QString &repository, const QString &arch,
+                           const QString &package);
+    void getBuildJob(const QString &project, const QString &repository, const QString &arch,
+                     const QString &package);
+    void getLastSucceededBuildLog(const QString &project, const QString &repository, const QString &arch,
+                                  const QString &package);
     void deleteProject(const QString &project);
     void deletePackage(const QString &project, const QString &package);
     void deleteFile(const QString &project, const QString &package, const QString &fileName);
@@ -92,9 +121,20 @@ signals:
     void selfSignedCertificateError(QNetworkReply *reply);
     void networkError(const QString &error);
     void requestDiffFetched(const QString &diff);
-    void fileFetched(const QString &fileName, const QByteArray &data);
+    void fileDownloaded(const QString &fileName, const QString &path);
+    void downloadProgress(const QString &fileName, qint64 bytesReceived, qint64 bytesTotal);
+    void uploadProgress(int token, const QString &fileName, qint64 bytesSent, qint64 bytesTotal);
     void buildLogFetched(const QString &buildLog);
     void buildLogNotFound();
+    void buildLogAppended(const QString &build, const QByteArray &data);
+    void buildLogTailFinished(const QString &build, bool ok);
+    void buildLogStatusFetched(const QString &build, const QString &code);
+    void buildJobFetched(const QString &build, const QString &job);
+    void lastSucceededBuildLogFetched(const QString &build, const QByteArray &data);
+    void lastSucceededBuildLogNotFound(const QString &build);
+    void resultsChanged(const QString &resource, OBSResultSet resultSet);
+    void staleDataLoaded(const QString &resource);
+    void dataRevalidated(const QString &resource);
     void projectNotFound(QSharedPointer<OBSStatus> status);
     void packageNotFound(QSharedPointer<OBSStatus> status);
     void cannotLinkPackage(QSharedPointer<OBSStatus> status);
@@ -114,6 +154,8 @@ private slots:
     void provideAuthentication(QNetworkReply *reply, QAuthenticator *authenticator);
     void replyFinished(QNetworkReply *reply);
     void onSslErrors(QNetworkReply *reply, const QList<QSslError> &list);
+    void onRequestStarted(quint64 requestId, QNetworkReply *reply);
+    void onRequestCanceled(quint64 requestId);
 
 private:
 /*
@@ -125,6 +167,39 @@ private:
  */
     QNetworkAccessManager *manager;
     void createManager();
+    QNetworkRequest createGetRequest(const QString &resource) const;
+
+/*
+ * Requests are queued in the scheduler and only get a reply once
+ * they are started. Until then their RequestInfo is kept in
+ * pendingRequests, keyed by the scheduler id. Requests made while a
+ * cancellation token is set can be dropped with cancelRequests().
+ *
+ */
+    OBSRequestScheduler *scheduler;
+    int cancellationToken;
+    int lastCancellationToken;
+
+/*
+ * Validators (ETag/Last-Modified) and body of the last 200 reply of
+ * conditional requests, keyed by URL. A 304 reply is answered with
+ * the cached body, which is then parsed as usual. Entries are also
+ * kept on disk (responseCache) so that they survive restarts. They
+ * are compressed and written there by cacheWriter, one at a time and
+ * in order, away from the GUI thread.
+ *
+ */
+    struct CachedReply {
+        QByteArray eTag;
+        QByteArray lastModified;
+        QByteArray data;
+    };
+    QCache<QString, CachedReply> replyCache;
+    OBSDiskCache responseCache;
+    QThreadPool *cacheWriter;
+    QString createCacheKey(const QUrl &url) const;
+    CachedReply *getCachedReply(const QUrl &url);
+    bool updateReplyCache(QNetworkReply *reply, QByteArray &data, int httpStatusCode);
     OBSCore();
     static OBSCore *instance;
     QString username;
@@ -142,6 +217,8 @@ private:
         Link,
         BuildStatus,
         BuildStatusList,
+        BuildResults,
+        WatchResults,
         IncomingRequests,
         OutgoingRequests,
         DeclinedRequests,
@@ -167,12 +244,78 @@ private:
         UpdatePerson,
         Distributions
     };
+
+/*
+ * Typed description of a request, stored per reply once started.
+ * Coalesced requests share a reply, so there can be several of them.
+ * finished is called when the reply succeeds. failed is called on
+ * errors and returns false to fall back to handleError(). started,
+ * if set, is called with the reply as soon as the request is sent.
+ * received, if set, is called with the body of a 200 reply as it
+ * arrives, and finished then only gets what had not been received.
+ *
+ */
+    typedef std::function<void(QNetworkReply *reply, const QByteArray &data)> ReplyHandler;
+    typedef std::function<bool(QNetworkReply *reply, const QByteArray &data)> ErrorHandler;
+    typedef std::function<void(QNetworkReply *reply)> StartHandler;
+    struct RequestInfo {
+        RequestType type = Login;
+        bool conditional = false;
+        int token = 0;
+        bool revalidate = false;
+        ReplyHandler finished;
+        ErrorHandler failed;
+        StartHandler started;
+        ReplyHandler received;
+    };
+    QHash<quint64, RequestInfo> pendingRequests;
+    QMultiHash<QNetworkReply *, RequestInfo> requests;
+    void resendUnconditionally(QNetworkReply *reply, const QList<RequestInfo> &infos, int token);
+    RequestInfo &setHandler(quint64 requestId, RequestType type,
+                            const ReplyHandler &finished, const ErrorHandler &failed = ErrorHandler());
+    RequestInfo &setHandler(QNetworkReply *reply, RequestType type,
+                            const ReplyHandler &finished, const ErrorHandler &failed = ErrorHandler());
+    static OBSRequestScheduler::Priority getPriority(RequestType type);
+    ReplyHandler parseWith(void (OBSXmlReader::*parser)(const QByteArray &));
+    RequestInfo &setStreamHandler(quint64 requestId, RequestType type, OBSXmlStream::Parser parser,
+                                  const OBSParseContext &context = OBSParseContext(),
+                                  const ErrorHandler &failed = ErrorHandler());
+    ErrorHandler packageNotFoundHandler();
+    void setBuildStatusHandler(quint64 requestId, int row);
+    void handleError(QNetworkReply *reply, const QByteArray &data);
+    struct FileDownload {
+        QString fileName;
+        QFile file;
+        qint64 offset;
+        QString error;
+    };
+    void writeDownload(QNetworkReply *reply, QSharedPointer<FileDownload> download, const QByteArray &data);
+    // Streamed replies, with the part of their body which has to be kept
+    QHash<QNetworkReply *, QByteArray> receivedData;
+    void receiveData(QNetworkReply *reply);
+    static QSharedPointer<OBSStatus> createErrorStatus(const QString &project, const QString &package,
+                                                       const QString &summary, const QString &details);
     bool m_authenticated;
     OBSXmlReader *xmlReader;
     bool includeHomeProjects;
     OBSLinkHelper *linkHelper;
     QString createReqResourceStr(const QString &states, const QString &roles) const;
     void getRequests(OBSCore::RequestType type);
+    QHash<QString, QString> watchedResults;
+    QHash<QString, int> watchCounts;
+    QHash<QString, QString> watchedStates;
+    QHash<QString, QNetworkReply *> watchReplies;
+    QHash<QString, int> watchRetryDelays;
+    // Watched replies being parsed, and how long they took (msec)
+    QHash<QString, qint64> watchParsing;
+    // Project results requests whose state starts the watch of the resource
+    QHash<QString, quint64> seedingResults;
+    void requestWatchedResults(const QString &resource);
+    void watchReplyFinished(QNetworkReply *reply, const QByteArray &data,
+                            const QString &resource, qint64 start);
+    void onWatchedResultsParsed(const QString &resource, const OBSResultSet &resultSet, const QString &state);
+    void onProjectResultsParsed(const QString &project, const QString &state);
+    void retryWatchedResults(const QString &resource);
 };
 
 #endif // OBSCORE_H
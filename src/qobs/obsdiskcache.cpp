@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "obsdiskcache.h"
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+static const quint32 cacheMagic = 0x51444331; // QDC1
+// Uncompressed size of the blocks an entry is stored in
+static const qint64 blockSize = 1024 * 1024;
+
+OBSDiskCache::OBSDiskCache(const QString &directory, qint64 maxSize) :
+    directory(directory),
+    maxSize(maxSize),
+    size(-1)
+{
+
+}
+
+QString OBSDiskCache::getDirectory() const
+{
+    QMutexLocker locker(&mutex);
+    return directory;
+}
+
+void OBSDiskCache::setDirectory(const QString &directory)
+{
+    QMutexLocker locker(&mutex);
+    this->directory = directory;
+    size = -1;
+}
+
+qint64 OBSDiskCache::getMaxSize() const
+{
+    QMutexLocker locker(&mutex);
+    return maxSize;
+}
+
+void OBSDiskCache::setMaxSize(qint64 maxSize)
+{
+    QMutexLocker locker(&mutex);
+    this->maxSize = maxSize;
+    expire();
+}
+
+QString OBSDiskCache::fileName(const QString &key) const
+{
+    QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return directory + "/" + QString::fromLatin1(hash);
+}
+
+bool OBSDiskCache::read(const QString &key, QByteArray &data)
+{
+    QMutexLocker locker(&mutex);
+    QFile file(fileName(key));
+    locker.unlock();
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    quint32 magic;
+    QString storedKey;
+    in >> magic >> storedKey;
+    bool valid = in.status() == QDataStream::Ok && magic == cacheMagic && storedKey == key;
+
+    // Blocks up to an empty one
+    data.clear();
+    while (valid) {
+        QByteArray block;
+        in >> block;
+        if (in.status() != QDataStream::Ok) {
+            valid = false;
+        } else if (block.isEmpty()) {
+            break;
+        } else {
+            data.append(qUncompress(block));
+        }
+    }
+
+    if (!valid) {
+        qDebug() << Q_FUNC_INFO << "Discarding invalid cache entry" << file.fileName();
+        file.close();
+        locker.relock();
+        removeFile(file.fileName());
+        data.clear();
+        return false;
+    }
+    file.close();
+
+    // Used as access time for the LRU policy
+    if (file.open(QIODevice::ReadWrite)) {
+        file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    }
+    return true;
+}
+
+bool OBSDiskCache::write(const QString &key, const QByteArray &data)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    return write(key, &buffer, data.size());
+}
+
+// Reads dataSize bytes from device; the entry is dropped if it ends before
+bool OBSDiskCache::write(const QString &key, QIODevice *device, qint64 dataSize)
+{
+    QMutexLocker locker(&mutex);
+    QString path = fileName(key);
+    locker.unlock();
+    if (!QDir().mkpath(QFileInfo(path).path())) {
+        qDebug() << Q_FUNC_INFO << "Cannot create cache directory" << QFileInfo(path).path();
+        return false;
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << Q_FUNC_INFO << "Cannot write" << path;
+        return false;
+    }
+    QDataStream out(&file);
+    out << cacheMagic << key;
+
+    for (qint64 left = dataSize; left > 0;) {
+        QByteArray block = device->read(qMin(left, blockSize));
+        if (block.isEmpty()) {
+            qDebug() << Q_FUNC_INFO << "Short read, discarding" << key;
+            file.cancelWriting();
+            return false;
+        }
+        left -= block.size();
+        out << qCompress(block);
+    }
+    out << QByteArray();
+
+    locker.relock();
+    qint64 oldSize = QFileInfo(path).size();
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qDebug() << Q_FUNC_INFO << "Cannot write" << path;
+        return false;
+    }
+
+    if (size >= 0) {
+        size += QFileInfo(path).size() - oldSize;
+    }
+    expire();
+    return true;
+}
+
+void OBSDiskCache::remove(const QString &key)
+{
+    QMutexLocker locker(&mutex);
+    removeFile(fileName(key));
+}
+
+void OBSDiskCache::removeFile(const QString &path)
+{
+    qint64 oldSize = QFileInfo(path).size();
+    if (QFile::remove(path) && size >= 0) {
+        size -= oldSize;
+    }
+}
+
+void OBSDiskCache::clear()
+{
+    QMutexLocker locker(&mutex);
+    QDir(directory).removeRecursively();
+    size = 0;
+}
+
+qint64 OBSDiskCache::cacheSize() const
+{
+    qint64 total = 0;
+    const QFileInfoList entries = QDir(directory).entryInfoList(QDir::Files);
+    for (const QFileInfo &entry : entries) {
+        total += entry.size();
+    }
+    return total;
+}
+
+void OBSDiskCache::expire()
+{
+    if (size < 0) {
+        size = cacheSize();
+    }
+    if (size <= maxSize) {
+        return;
+    }
+
+    // Oldest first, down to 90% of maxSize
+    QFileInfoList entries = QDir(directory).entryInfoList(QDir::Files, QDir::Time | QDir::Reversed);
+    qint64 goal = maxSize * 9 / 10;
+    for (const QFileInfo &entry : entries) {
+        if (size <= goal) {
+            break;
+        }
+        if (QFile::remove(entry.absoluteFilePath())) {
+            size -= entry.size();
+        }
+    }
+    qDebug() << Q_FUNC_INFO << "Cache size:" << size;
+}
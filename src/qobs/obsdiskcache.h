@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef OBSDISKCACHE_H
+#define OBSDISKCACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QIODevice>
+#include <QMutex>
+
+/*
+ * Size-bounded on-disk store of compressed entries, one file per key
+ * (e.g. API replies, build logs). Entries are compressed in blocks,
+ * so that large ones can be written from a device without holding
+ * them in memory. When the store grows over its maximum size, the
+ * least recently used entries are removed.
+ *
+ * All methods can be called from any thread. Entries are written to
+ * a temporary file and replaced at once, so that a write doesn't
+ * block reads of other entries.
+ *
+ */
+class OBSDiskCache
+{
+public:
+    OBSDiskCache(const QString &directory, qint64 maxSize);
+
+    QString getDirectory() const;
+    void setDirectory(const QString &directory);
+
+    qint64 getMaxSize() const;
+    void setMaxSize(qint64 maxSize);
+
+    bool read(const QString &key, QByteArray &data);
+    bool write(const QString &key, const QByteArray &data);
+    bool write(const QString &key, QIODevice *device, qint64 dataSize);
+    void remove(const QString &key);
+    void clear();
+
+private:
+    mutable QMutex mutex;
+    QString directory;
+    qint64 maxSize;
+    qint64 size;
+    QString fileName(const QString &key) const;
+    void removeFile(const QString &path);
+    qint64 cacheSize() const;
+    void expire();
+};
+
+#endif // OBSDISKCACHE_H
@@ -0,0 +1,358 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "obsrequestscheduler.h"
+#include <QDebug>
+#include <QTimer>
+#include <QPair>
+
+// Slots per host which only interactive requests can use
+static const int reservedInteractiveRequests = 1;
+static const int maxBulkRequestsPerHost = 2;
+
+OBSRequestScheduler::OBSRequestScheduler(QObject *parent) :
+    QObject(parent),
+    manager(nullptr),
+    maxRequestsPerHost(6),
+    lastId(0),
+    pumpScheduled(false)
+{
+
+}
+
+void OBSRequestScheduler::setManager(QNetworkAccessManager *manager)
+{
+    clear();
+    this->manager = manager;
+}
+
+int OBSRequestScheduler::getMaxRequestsPerHost() const
+{
+    return maxRequestsPerHost;
+}
+
+void OBSRequestScheduler::setMaxRequestsPerHost(int maxRequestsPerHost)
+{
+    this->maxRequestsPerHost = qMax(reservedInteractiveRequests + 1, maxRequestsPerHost);
+    schedulePump();
+}
+
+quint64 OBSRequestScheduler::enqueue(QNetworkAccessManager::Operation operation, const QNetworkRequest &request,
+                                     const QByteArray &data, int token)
+{
+    if (operation == QNetworkAccessManager::GetOperation && !request.attribute(ExclusiveAttribute).toBool()) {
+        quint64 id = coalesce(request, token);
+        if (id != 0) {
+            return id;
+        }
+    }
+
+    Job job;
+    job.operation = operation;
+    job.request = request;
+    job.data = data;
+    job.device = nullptr;
+    job.token = token;
+    return enqueue(job);
+}
+
+quint64 OBSRequestScheduler::enqueue(QNetworkAccessManager::Operation operation, const QNetworkRequest &request,
+                                     QIODevice *device, int token)
+{
+    device->setParent(this);
+
+    Job job;
+    job.operation = operation;
+    job.request = request;
+    job.device = device;
+    job.token = token;
+    return enqueue(job);
+}
+
+quint64 OBSRequestScheduler::enqueue(const Job &job)
+{
+    Job queuedJob = job;
+    queuedJob.id = ++lastId;
+    lanes[Interactive].append(queuedJob);
+    schedulePump();
+    return queuedJob.id;
+}
+
+void OBSRequestScheduler::drop(const Job &job)
+{
+    if (job.device) {
+        job.device->deleteLater();
+    }
+    emit canceled(job.id);
+    foreach (quint64 id, job.followers) {
+        emit canceled(id);
+    }
+}
+
+void OBSRequestScheduler::setPriority(quint64 id, OBSRequestScheduler::Priority priority)
+{
+    for (int lane = Interactive; lane <= Bulk; lane++) {
+        for (int i = 0; i < lanes[lane].size(); i++) {
+            const Job &job = lanes[lane].at(i);
+            if (job.id == id || job.followers.contains(id)) {
+                // Coalesced requests can only raise the priority of the shared one
+                if (lane != priority && (job.id == id || priority < lane)) {
+                    lanes[priority].append(lanes[lane].takeAt(i));
+                }
+                return;
+            }
+        }
+    }
+}
+
+void OBSRequestScheduler::cancel(int token)
+{
+    if (token == 0) {
+        return;
+    }
+
+    for (int lane = Interactive; lane <= Bulk; lane++) {
+        for (auto it = lanes[lane].begin(); it != lanes[lane].end();) {
+            if (it->token == token) {
+                Job job = *it;
+                it = lanes[lane].erase(it);
+                drop(job);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // Aborting emits finished(), which frees the slot
+    QList<QNetworkReply *> replies;
+    QList<quint64> attached;
+    for (auto it = running.begin(); it != running.end(); ++it) {
+        if (it.value().job.token == token) {
+            replies.append(it.key());
+            attached.append(it.value().attached);
+            it.value().attached.clear();
+        }
+    }
+    foreach (quint64 id, attached) {
+        emit canceled(id);
+    }
+    foreach (QNetworkReply *reply, replies) {
+        qDebug() << Q_FUNC_INFO << "Aborting" << reply->url().toString();
+        reply->abort();
+    }
+}
+
+void OBSRequestScheduler::clear()
+{
+    for (int lane = Interactive; lane <= Bulk; lane++) {
+        QList<Job> jobs = lanes[lane];
+        lanes[lane].clear();
+        foreach (const Job &job, jobs) {
+            drop(job);
+        }
+    }
+
+    // Running replies belong to the manager
+    QList<quint64> attached;
+    foreach (const RunningJob &runningJob, running) {
+        attached.append(runningJob.attached);
+    }
+    running.clear();
+    foreach (quint64 id, attached) {
+        emit canceled(id);
+    }
+    runningPerHost.clear();
+    bulkPerHost.clear();
+}
+
+QString OBSRequestScheduler::hostKey(const QUrl &url)
+{
+    return url.host() + ":" + QString::number(url.port(url.scheme() == "http" ? 80 : 443));
+}
+
+// A conditional GET can get a 304 with no body, which an unconditional one cannot use
+bool OBSRequestScheduler::canCoalesce(const Job &job, const QNetworkRequest &request, int token)
+{
+    return job.operation == QNetworkAccessManager::GetOperation && job.token == token
+            && job.request.url() == request.url() && !job.request.attribute(ExclusiveAttribute).toBool()
+            && job.request.rawHeader("If-None-Match") == request.rawHeader("If-None-Match")
+            && job.request.rawHeader("If-Modified-Since") == request.rawHeader("If-Modified-Since");
+}
+
+quint64 OBSRequestScheduler::coalesce(const QNetworkRequest &request, int token)
+{
+    for (int lane = Interactive; lane <= Bulk; lane++) {
+        for (Job &job : lanes[lane]) {
+            if (canCoalesce(job, request, token)) {
+                quint64 id = ++lastId;
+                job.followers.append(id);
+                qDebug() << Q_FUNC_INFO << "Queued:" << request.url().toString();
+                return id;
+            }
+        }
+    }
+
+    for (auto it = running.begin(); it != running.end(); ++it) {
+        const Job &job = it.value().job;
+        if (canCoalesce(job, request, token) && !it.value().receiving && !it.key()->isFinished()) {
+            // Attached on the next pump, once the caller has set up its request
+            quint64 id = ++lastId;
+            it.value().attached.append(id);
+            schedulePump();
+            qDebug() << Q_FUNC_INFO << "Running:" << request.url().toString();
+            return id;
+        }
+    }
+
+    return 0;
+}
+
+bool OBSRequestScheduler::canStart(const QString &host, Priority priority) const
+{
+    int runningRequests = runningPerHost.value(host);
+    if (priority == Interactive) {
+        return runningRequests < maxRequestsPerHost;
+    }
+    if (runningRequests >= maxRequestsPerHost - reservedInteractiveRequests) {
+        return false;
+    }
+    return priority != Bulk || bulkPerHost.value(host) < maxBulkRequestsPerHost;
+}
+
+void OBSRequestScheduler::start(const Job &job, Priority priority)
+{
+    QNetworkReply *reply = nullptr;
+
+    switch (job.operation) {
+    case QNetworkAccessManager::PostOperation:
+        reply = job.device ? manager->post(job.request, job.device) : manager->post(job.request, job.data);
+        break;
+    case QNetworkAccessManager::PutOperation:
+        reply = job.device ? manager->put(job.request, job.device) : manager->put(job.request, job.data);
+        break;
+    case QNetworkAccessManager::DeleteOperation:
+        reply = manager->deleteResource(job.request);
+        break;
+    default:
+        reply = manager->get(job.request);
+        break;
+    }
+
+    if (job.device) {
+        job.device->setParent(reply);
+    }
+
+    RunningJob runningJob;
+    runningJob.host = hostKey(job.request.url());
+    runningJob.priority = priority;
+    runningJob.job = job;
+    runningJob.job.followers.clear();
+    runningJob.receiving = false;
+    running.insert(reply, runningJob);
+    runningPerHost[runningJob.host]++;
+    if (priority == Bulk) {
+        bulkPerHost[runningJob.host]++;
+    }
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        onReplyFinished(reply);
+    });
+    // Connected before the handlers, which may read the body as it arrives
+    connect(reply, &QNetworkReply::readyRead, this, [this, reply]() {
+        auto it = running.find(reply);
+        if (it != running.end()) {
+            it.value().receiving = true;
+        }
+    });
+    emit started(job.id, reply);
+    foreach (quint64 id, job.followers) {
+        emit started(id, reply);
+    }
+}
+
+void OBSRequestScheduler::schedulePump()
+{
+    if (!pumpScheduled) {
+        pumpScheduled = true;
+        QTimer::singleShot(0, this, &OBSRequestScheduler::pump);
+    }
+}
+
+void OBSRequestScheduler::pump()
+{
+    pumpScheduled = false;
+    if (!manager) {
+        return;
+    }
+
+    QList<QPair<quint64, QNetworkReply *>> attached;
+    for (auto it = running.begin(); it != running.end(); ++it) {
+        if (it.value().receiving) {
+            // Part of the body may have been read already, send them again
+            requeue(it.value(), it.value().attached);
+        } else {
+            foreach (quint64 id, it.value().attached) {
+                attached.append(qMakePair(id, it.key()));
+            }
+        }
+        it.value().attached.clear();
+    }
+    for (const auto &pair : attached) {
+        emit started(pair.first, pair.second);
+    }
+
+    for (int lane = Interactive; lane <= Bulk; lane++) {
+        Priority priority = static_cast<Priority>(lane);
+        for (auto it = lanes[lane].begin(); it != lanes[lane].end();) {
+            if (canStart(hostKey(it->request.url()), priority)) {
+                Job job = *it;
+                it = lanes[lane].erase(it);
+                start(job, priority);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+void OBSRequestScheduler::onReplyFinished(QNetworkReply *reply)
+{
+    if (!running.contains(reply)) {
+        return;
+    }
+
+    RunningJob runningJob = running.take(reply);
+    runningPerHost[runningJob.host]--;
+    if (runningJob.priority == Bulk) {
+        bulkPerHost[runningJob.host]--;
+    }
+
+    // The reply finished before they could be attached to it, send them again
+    requeue(runningJob, runningJob.attached);
+    schedulePump();
+}
+
+// The first request is sent again, the others are coalesced with it
+void OBSRequestScheduler::requeue(const RunningJob &runningJob, const QList<quint64> &ids)
+{
+    if (ids.isEmpty()) {
+        return;
+    }
+    Job job = runningJob.job;
+    job.id = ids.first();
+    job.followers = ids.mid(1);
+    lanes[runningJob.priority].append(job);
+    schedulePump();
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef OBSREQUESTSCHEDULER_H
+#define OBSREQUESTSCHEDULER_H
+
+#include <QObject>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QHash>
+#include <QList>
+
+/*
+ * Queues requests and starts them on the QNAM with a per-host limit.
+ *
+ * Requests are queued in three lanes. Interactive requests (what the
+ * user is waiting for) always go first and have one slot per host
+ * reserved for them. Background requests (monitor, request box) come
+ * next and bulk transfers (logs, downloads, uploads) last, with at
+ * most maxBulkRequestsPerHost of them running at once.
+ *
+ * Requests are started on the next event loop iteration, so that the
+ * caller can still change their priority after enqueueing them.
+ * A request can carry a cancellation token; cancel() drops the queued
+ * requests with that token and aborts the running ones.
+ *
+ * Bodies can also be streamed from a QIODevice, which the scheduler
+ * takes ownership of. It is deleted along with the reply, or right
+ * away if the request is canceled before being started.
+ *
+ * A GET for a URL which is already queued or running (with the same
+ * token and validators, e.g. If-None-Match) is not sent again. It gets its own id, but it is started
+ * with the reply of the request it was coalesced with. Replies can
+ * be read as they arrive, so a running one is only shared until it
+ * starts receiving its body; later requests are sent on their own.
+ *
+ */
+class OBSRequestScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Priority {
+        Interactive,
+        Background,
+        Bulk
+    };
+    // Requests with this attribute set get a reply of their own (e.g. streamed downloads)
+    static const QNetworkRequest::Attribute ExclusiveAttribute = QNetworkRequest::User;
+    explicit OBSRequestScheduler(QObject *parent = nullptr);
+    void setManager(QNetworkAccessManager *manager);
+    int getMaxRequestsPerHost() const;
+    void setMaxRequestsPerHost(int maxRequestsPerHost);
+    quint64 enqueue(QNetworkAccessManager::Operation operation, const QNetworkRequest &request,
+                    const QByteArray &data = QByteArray(), int token = 0);
+    quint64 enqueue(QNetworkAccessManager::Operation operation, const QNetworkRequest &request,
+                    QIODevice *device, int token = 0);
+    void setPriority(quint64 id, OBSRequestScheduler::Priority priority);
+    void cancel(int token);
+    void clear();
+
+signals:
+    void started(quint64 id, QNetworkReply *reply);
+    void canceled(quint64 id);
+
+private:
+    struct Job {
+        quint64 id;
+        QNetworkAccessManager::Operation operation;
+        QNetworkRequest request;
+        QByteArray data;
+        QIODevice *device;
+        int token;
+        QList<quint64> followers;
+    };
+    struct RunningJob {
+        QString host;
+        Priority priority;
+        Job job;
+        QList<quint64> attached;
+        bool receiving;
+    };
+    QNetworkAccessManager *manager;
+    QList<Job> lanes[Bulk + 1];
+    QHash<QNetworkReply *, RunningJob> running;
+    QHash<QString, int> runningPerHost;
+    QHash<QString, int> bulkPerHost;
+    int maxRequestsPerHost;
+    quint64 lastId;
+    bool pumpScheduled;
+    static QString hostKey(const QUrl &url);
+    static bool canCoalesce(const Job &job, const QNetworkRequest &request, int token);
+    quint64 coalesce(const QNetworkRequest &request, int token);
+    quint64 enqueue(const Job &job);
+    void drop(const Job &job);
+    bool canStart(const QString &host, Priority priority) const;
+    void start(const Job &job, Priority priority);
+    void requeue(const RunningJob &runningJob, const QList<quint64> &ids);
+    void schedulePump();
+    void pump();
+    void onReplyFinished(QNetworkReply *reply);
+};
+
+#endif // OBSREQUESTSCHEDULER_H
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "obsresultdiff.h"
+
+OBSResultDiff::OBSResultDiff()
+{
+
+}
+
+void OBSResultDiff::update(const OBSResultSet &resultSet)
+{
+    added.clear();
+    removed.clear();
+    changed.clear();
+
+    QHash<Build, Status> newStatuses;
+    newStatuses.reserve(resultSet.size());
+    Build build;
+    Status status;
+
+    for (int i = 0; i < resultSet.size(); i++) {
+        OBSResultSet::Row row = resultSet.at(i);
+        build.project = row.getProject();
+        build.repository = row.getRepository();
+        build.arch = row.getArch();
+        build.package = row.getPackage();
+        status.code = row.getCode();
+        status.codeId = row.getCodeId();
+        status.details = row.getDetails();
+
+        // What is left in statuses afterwards has been removed
+        auto it = statuses.find(build);
+        if (it == statuses.end()) {
+            added.append({build, QString(), status.code, status.details});
+        } else {
+            if (!OBSStatus::isSameCode(it->codeId, it->code, status.codeId, status.code)
+                    || it->details != status.details) {
+                changed.append({build, it->code, status.code, status.details});
+            }
+            statuses.erase(it);
+        }
+        newStatuses.insert(build, status);
+    }
+
+    for (auto it = statuses.cbegin(); it != statuses.cend(); ++it) {
+        removed.append({it.key(), it->code, it->code, it->details});
+    }
+    statuses = newStatuses;
+}
+
+void OBSResultDiff::clear()
+{
+    statuses.clear();
+    added.clear();
+    removed.clear();
+    changed.clear();
+}
+
+QList<OBSResultDiff::Change> OBSResultDiff::getAdded() const
+{
+    return added;
+}
+
+QList<OBSResultDiff::Change> OBSResultDiff::getRemoved() const
+{
+    return removed;
+}
+
+QList<OBSResultDiff::Change> OBSResultDiff::getChanged() const
+{
+    return changed;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef OBSRESULTDIFF_H
+#define OBSRESULTDIFF_H
+
+#include <QString>
+#include <QList>
+#include <QHash>
+#include "obsresultset.h"
+#include "obsstatus.h"
+
+/*
+ * Differences between consecutive result lists of the same resource.
+ *
+ * Statuses are keyed by (project, repository, arch, package), so
+ * update() finds the added, removed and changed builds with one hash
+ * lookup per status. The last result list is kept as the base for
+ * the next update.
+ *
+ */
+class OBSResultDiff
+{
+public:
+    struct Build {
+        QString project;
+        QString repository;
+        QString arch;
+        QString package;
+        bool operator==(const Build &other) const
+        {
+            return project == other.project && repository == other.repository
+                    && arch == other.arch && package == other.package;
+        }
+    };
+    struct Change {
+        Build build;
+        QString oldCode;
+        QString code;
+        QString details;
+    };
+    OBSResultDiff();
+    void update(const OBSResultSet &resultSet);
+    void clear();
+    QList<Change> getAdded() const;
+    QList<Change> getRemoved() const;
+    QList<Change> getChanged() const;
+
+private:
+    struct Status {
+        QString code;
+        OBSStatus::Code codeId;
+        QString details;
+    };
+    QHash<Build, Status> statuses;
+    QList<Change> added;
+    QList<Change> removed;
+    QList<Change> changed;
+};
+
+inline size_t qHash(const OBSResultDiff::Build &build, size_t seed = 0)
+{
+    return qHashMulti(seed, build.project, build.repository, build.arch, build.package);
+}
+
+#endif // OBSRESULTDIFF_H
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "obsresultset.h"
+
+OBSResultSet::Row::Row(const OBSResultSet *resultSet, int index) :
+    resultSet(resultSet),
+    index(index),
+    result(resultSet->results.at(index))
+{
+
+}
+
+QString OBSResultSet::Row::getProject() const
+{
+    return resultSet->names.at(resultSet->projects.at(result));
+}
+
+QString OBSResultSet::Row::getRepository() const
+{
+    return resultSet->names.at(resultSet->repositories.at(result));
+}
+
+QString OBSResultSet::Row::getArch() const
+{
+    return resultSet->names.at(resultSet->archs.at(result));
+}
+
+QString OBSResultSet::Row::getState() const
+{
+    return resultSet->names.at(resultSet->states.at(result));
+}
+
+QString OBSResultSet::Row::getPackage() const
+{
+    return resultSet->names.at(resultSet->packages.at(index));
+}
+
+QString OBSResultSet::Row::getCode() const
+{
+    return resultSet->names.at(resultSet->codes.at(index));
+}
+
+OBSStatus::Code OBSResultSet::Row::getCodeId() const
+{
+    return static_cast<OBSStatus::Code>(resultSet->codeIds.at(index));
+}
+
+QString OBSResultSet::Row::getDetails() const
+{
+    int start = resultSet->detailsOffsets.at(index);
+    int end = index + 1 < resultSet->detailsOffsets.size() ? resultSet->detailsOffsets.at(index + 1)
+                                                           : resultSet->details.size();
+    return resultSet->details.mid(start, end - start);
+}
+
+OBSResultSet::OBSResultSet()
+{
+
+}
+
+void OBSResultSet::appendResult(QStringView project, QStringView repository, QStringView arch,
+                                QStringView state)
+{
+    projects.append(names.intern(project));
+    repositories.append(names.intern(repository));
+    archs.append(names.intern(arch));
+    states.append(names.intern(state));
+}
+
+void OBSResultSet::appendStatus(QStringView package, QStringView code)
+{
+    if (projects.isEmpty()) {
+        return;
+    }
+    results.append(projects.size() - 1);
+    packages.append(names.intern(package));
+    codes.append(names.intern(code));
+    codeIds.append(OBSStatus::codeFromString(code));
+    detailsOffsets.append(details.size());
+}
+
+void OBSResultSet::appendDetails(const QString &details)
+{
+    if (!results.isEmpty()) {
+        this->details.append(details);
+    }
+}
+
+void OBSResultSet::append(const OBSResultSet &other)
+{
+    // An empty set takes the pool of the other one, ids and all
+    if (projects.isEmpty()) {
+        *this = other;
+        return;
+    }
+
+    // Otherwise each name of the other pool is interned once, and cells are remapped by id
+    QVector<int> ids(other.names.size(), -1);
+    auto remap = [this, &other, &ids](int id) {
+        if (ids.at(id) < 0) {
+            ids[id] = names.intern(other.names.at(id));
+        }
+        return ids.at(id);
+    };
+
+    int resultOffset = projects.size();
+    for (int result = 0; result < other.projects.size(); result++) {
+        projects.append(remap(other.projects.at(result)));
+        repositories.append(remap(other.repositories.at(result)));
+        archs.append(remap(other.archs.at(result)));
+        states.append(remap(other.states.at(result)));
+    }
+
+    int detailsOffset = details.size();
+    for (int status = 0; status < other.results.size(); status++) {
+        results.append(resultOffset + other.results.at(status));
+        packages.append(remap(other.packages.at(status)));
+        codes.append(remap(other.codes.at(status)));
+        detailsOffsets.append(detailsOffset + other.detailsOffsets.at(status));
+    }
+    codeIds.append(other.codeIds);
+    details.append(other.details);
+}
+
+void OBSResultSet::clear()
+{
+    *this = OBSResultSet();
+}
+
+bool OBSResultSet::isEmpty() const
+{
+    return results.isEmpty();
+}
+
+int OBSResultSet::size() const
+{
+    return results.size();
+}
+
+OBSResultSet::Row OBSResultSet::at(int index) const
+{
+    return Row(this, index);
+}
+
+int OBSResultSet::getResultCount() const
+{
+    return projects.size();
+}
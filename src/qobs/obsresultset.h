@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef OBSRESULTSET_H
+#define OBSRESULTSET_H
+
+#include <QString>
+#include <QStringView>
+#include <QVector>
+#include "obsstatus.h"
+#include "obsstringpool.h"
+
+/*
+ * Build results of a _result reply, stored column by column.
+ *
+ * Each result (a repository/arch of a project) and each of its
+ * statuses is a few ints in contiguous arrays: names are pooled once
+ * per set (straight from the parser's views) and referred to by id,
+ * and all the details share a single buffer. Row is a view of a
+ * status together with its result, so going through the statuses
+ * allocates nothing but the strings which are actually read.
+ *
+ * Statuses are appended to the last appended result, and details to
+ * the last appended status. Copies are cheap (the arrays are
+ * implicitly shared).
+ *
+ */
+class OBSResultSet
+{
+public:
+    class Row
+    {
+    public:
+        QString getProject() const;
+        QString getRepository() const;
+        QString getArch() const;
+        QString getState() const;
+        QString getPackage() const;
+        QString getCode() const;
+        OBSStatus::Code getCodeId() const;
+        QString getDetails() const;
+
+    private:
+        friend class OBSResultSet;
+        Row(const OBSResultSet *resultSet, int index);
+        const OBSResultSet *resultSet;
+        int index;
+        int result;
+    };
+
+    OBSResultSet();
+    void appendResult(QStringView project, QStringView repository, QStringView arch, QStringView state);
+    void appendStatus(QStringView package, QStringView code);
+    void appendDetails(const QString &details);
+    void append(const OBSResultSet &other);
+    void clear();
+    bool isEmpty() const;
+    int size() const;
+    Row at(int index) const;
+    int getResultCount() const;
+
+private:
+    OBSStringPool names;
+    // One entry per result
+    QVector<int> projects;
+    QVector<int> repositories;
+    QVector<int> archs;
+    QVector<int> states;
+    // One entry per status
+    QVector<int> results;
+    QVector<int> packages;
+    QVector<int> codes;
+    QVector<quint8> codeIds;
+    QVector<int> detailsOffsets;
+    QString details;
+};
+
+#endif // OBSRESULTSET_H
@@ -14,13 +14,16 @@
  * limitations under the License.
  */
 #include "obsstatus.h"
+#include <QLatin1String>
 
-OBSStatus::OBSStatus()
+OBSStatus::OBSStatus() :
+    codeId(Other)
 {
 
 }
 
-OBSStatus::OBSStatus(const OBSStatus &other)
+OBSStatus::OBSStatus(const OBSStatus &other) :
+    codeId(Other)
 {
     *this = other;
 }
@@ -43,6 +46,54 @@ QString OBSStatus::getCode() const
 void OBSStatus::setCode(const QString &value)
 {
     code = value;
+    codeId = codeFromString(value);
+}
+
+OBSStatus::Code OBSStatus::getCodeId() const
+{
+    return codeId;
+}
+
+bool OBSStatus::hasSameCode(const OBSStatus &other) const
+{
+    return isSameCode(codeId, code, other.codeId, other.code);
+}
+
+bool OBSStatus::isSameCode(Code codeId, QStringView code, Code otherCodeId, QStringView otherCode)
+{
+    // Codes which are not build codes can only be told apart by name
+    return codeId == otherCodeId && (codeId != Other || code == otherCode);
+}
+
+OBSStatus::Code OBSStatus::codeFromString(QStringView code)
+{
+    static const struct {
+        QLatin1String name;
+        Code code;
+    } codes[] = {
+        {QLatin1String("succeeded"), Succeeded},
+        {QLatin1String("failed"), Failed},
+        {QLatin1String("unresolvable"), Unresolvable},
+        {QLatin1String("broken"), Broken},
+        {QLatin1String("blocked"), Blocked},
+        {QLatin1String("dispatching"), Dispatching},
+        {QLatin1String("scheduled"), Scheduled},
+        {QLatin1String("building"), Building},
+        {QLatin1String("signing"), Signing},
+        {QLatin1String("finished"), Finished},
+        {QLatin1String("disabled"), Disabled},
+        {QLatin1String("excluded"), Excluded},
+        {QLatin1String("locked"), Locked},
+        {QLatin1String("deleting"), Deleting},
+        {QLatin1String("unknown"), Unknown}
+    };
+
+    for (const auto &entry : codes) {
+        if (code == entry.name) {
+            return entry.code;
+        }
+    }
+    return Other;
 }
 
 QString OBSStatus::getSummary() const
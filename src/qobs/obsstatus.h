@@ -17,22 +17,46 @@
 #define OBSSTATUS_H
 
 #include <QString>
+#include <QStringView>
 #include "obsobject.h"
 
 class OBSStatus : public OBSObject
 {
 public:
+    // Build status codes. Other is any other code (e.g. "ok" in API replies)
+    enum Code {
+        Other,
+        Succeeded,
+        Failed,
+        Unresolvable,
+        Broken,
+        Blocked,
+        Dispatching,
+        Scheduled,
+        Building,
+        Signing,
+        Finished,
+        Disabled,
+        Excluded,
+        Locked,
+        Deleting,
+        Unknown
+    };
     OBSStatus();
     OBSStatus(const OBSStatus &other);
     OBSStatus &operator=(const OBSStatus &other);
     inline bool operator==(const OBSStatus &rhs)
     {
         return this->getProject()==rhs.getProject() && this->getPackage()==rhs.getPackage() &&
-                this->getCode()==rhs.getCode();
+                hasSameCode(rhs);
     }
 
     QString getCode() const;
     void setCode(const QString &value);
+    Code getCodeId() const;
+    bool hasSameCode(const OBSStatus &other) const;
+    static bool isSameCode(Code codeId, QStringView code, Code otherCodeId, QStringView otherCode);
+    static Code codeFromString(QStringView code);
 
     QString getSummary() const;
     void setSummary(const QString &value);
@@ -42,6 +66,7 @@ public:
 
 private:
     QString code;
+    Code codeId;
     QString summary;
     QString details;
 };
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "obsstringpool.h"
+
+OBSStringPool::OBSStringPool()
+{
+    intern(QStringView());
+}
+
+int OBSStringPool::intern(QStringView value)
+{
+    auto it = ids.constFind(value);
+    if (it != ids.constEnd()) {
+        return it.value();
+    }
+    strings.append(value.toString());
+    ids.insert(QStringView(strings.constLast()), strings.size() - 1);
+    return strings.size() - 1;
+}
+
+// Returns -1 if value is not pooled
+int OBSStringPool::find(QStringView value) const
+{
+    return ids.value(value, -1);
+}
+
+const QString &OBSStringPool::at(int id) const
+{
+    return strings.at(id);
+}
+
+int OBSStringPool::size() const
+{
+    return strings.size();
+}
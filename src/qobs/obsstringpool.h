@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef OBSSTRINGPOOL_H
+#define OBSSTRINGPOOL_H
+
+#include <QString>
+#include <QStringView>
+#include <QStringList>
+#include <QHash>
+
+/*
+ * Names which repeat all over build results (projects, repositories,
+ * archs, packages and status codes), stored once and referred to by
+ * id. Id 0 is the empty string.
+ *
+ * Each owner (e.g. a result set, the monitor model) has its own pool,
+ * so no locking is needed. Lookups take a view, e.g. straight from
+ * the XML reader, and do not allocate when the name is already
+ * pooled. Copies are cheap (the storage is implicitly shared).
+ *
+ */
+class OBSStringPool
+{
+public:
+    OBSStringPool();
+    int intern(QStringView value);
+    int find(QStringView value) const;
+    const QString &at(int id) const;
+    int size() const;
+
+private:
+    QStringList strings;
+    // Keys point into the pooled strings
+    QHash<QStringView, int> ids;
+};
+
+#endif // OBSSTRINGPOOL_H
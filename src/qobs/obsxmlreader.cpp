@@ -14,12 +14,28 @@
  * limitations under the License.
  */
 #include "obsxmlreader.h"
+#include <QLatin1String>
+#include <QMutexLocker>
+
+// Projects in the first partial list of a streamed project list
+static const int firstProjectBatch = 1000;
 
 OBSXmlReader *OBSXmlReader::instance = nullptr;
 
-OBSXmlReader::OBSXmlReader()
+OBSXmlReader::OBSXmlReader() :
+    threadPool(new QThreadPool(this))
 {
-
+    qRegisterMetaType<QSharedPointer<OBSStatus>>();
+    qRegisterMetaType<QSharedPointer<OBSRevision>>();
+    qRegisterMetaType<QSharedPointer<OBSRequest>>();
+    qRegisterMetaType<OBSResultSet>();
+    qRegisterMetaType<QSharedPointer<OBSFile>>();
+    qRegisterMetaType<QSharedPointer<OBSLink>>();
+    qRegisterMetaType<QSharedPointer<OBSAbout>>();
+    qRegisterMetaType<QSharedPointer<OBSPerson>>();
+    qRegisterMetaType<QSharedPointer<OBSPrjMetaConfig>>();
+    qRegisterMetaType<QSharedPointer<OBSPkgMetaConfig>>();
+    qRegisterMetaType<QSharedPointer<OBSDistribution>>();
 }
 
 OBSXmlReader *OBSXmlReader::getInstance()
@@ -30,7 +46,56 @@ OBSXmlReader *OBSXmlReader::getInstance()
     return instance;
 }
 
-void OBSXmlReader::addData(const QString &data)
+void OBSXmlReader::parseStream(QSharedPointer<OBSXmlStream> stream, const QByteArray &data, bool finished)
+{
+    {
+        QMutexLocker locker(&stream->mutex);
+        stream->pending.append(data);
+        stream->pendingFinished = stream->pendingFinished || finished;
+    }
+    startStream(stream);
+}
+
+void OBSXmlReader::abortStream(QSharedPointer<OBSXmlStream> stream)
+{
+    {
+        QMutexLocker locker(&stream->mutex);
+        stream->pendingFinished = true;
+        stream->pendingFailed = true;
+    }
+    startStream(stream);
+}
+
+void OBSXmlReader::startStream(QSharedPointer<OBSXmlStream> stream)
+{
+    // Tasks can start in any order, the first one parses all the pending data
+    threadPool->start([this, stream]() {
+        QMutexLocker parseLocker(&stream->parseMutex);
+        QByteArray pending;
+        bool pendingFinished;
+        bool pendingFailed;
+        {
+            QMutexLocker locker(&stream->mutex);
+            pending.swap(stream->pending);
+            pendingFinished = stream->pendingFinished;
+            pendingFailed = stream->pendingFailed;
+        }
+
+        if (stream->finished || (pending.isEmpty() && !pendingFinished)) {
+            return;
+        }
+        if (pendingFailed) {
+            // An incomplete document, which the parser reports as such
+            stream->buffer.clear();
+        } else {
+            stream->buffer.append(pending);
+        }
+        stream->finished = pendingFinished;
+        (this->*stream->parser)(*stream);
+    });
+}
+
+void OBSXmlReader::addData(const OBSParseContext &context, const QByteArray &data)
 {
     qDebug() << Q_FUNC_INFO;
     QXmlStreamReader xml(data);
@@ -38,53 +103,71 @@ void OBSXmlReader::addData(const QString &data)
     while (!xml.atEnd() && !xml.hasError()) {
         xml.readNext();
 
-        if (xml.name().toString() == "resultlist" && xml.isStartElement()) {
-            parseResultList(data);
-        } else if (xml.name().toString() == "status" && xml.isStartElement()) {
-            parseBuildStatus(data);
+        if (xml.isStartElement()) {
+            OBSXmlToken::Name token = OBSXmlToken::fromName(xml.name());
+            if (token == OBSXmlToken::ResultList) {
+                parseResultList(data);
+            } else if (token == OBSXmlToken::Status) {
+                parseBuildStatus(context, data);
+            }
         }
     }
 }
 
-void OBSXmlReader::parseProjectList(const QString &userHome, const QString &data)
+void OBSXmlReader::parseProjectList(const QString &userHome, const QByteArray &data)
 {
     QXmlStreamReader xml(data);
-
     QStringList list;
 
-    while (!xml.atEnd() && !xml.hasError()) {
-        xml.readNext();
+    parseProjectEntries(xml, userHome, list);
 
-        if (xml.name().toString() == "entry") {
-            if (xml.isStartElement()) {
-                QXmlStreamAttributes attrib = xml.attributes();
-                QString entry = attrib.value("name").toString();
-                if (!userHome.isEmpty()) {
-                    if (entry.startsWith(userHome)) {
-                        list.append(entry);
-                        emit projectFetched(entry);
-                    }
-                    if (!entry.startsWith("home")) {
-                        list.append(entry);
-                        emit projectFetched(entry);
-                    }
-                } else {
+    if (xml.hasError()) {
+        qDebug() << Q_FUNC_INFO << "Error parsing XML!" << xml.errorString();
+    }
+
+    emit finishedParsingProjectList(list);
+}
+
+void OBSXmlReader::parseProjectListStream(OBSXmlStream &stream)
+{
+    feedStream(stream, ">");
+    parseProjectEntries(stream.xml, stream.context.userHome, stream.list);
+
+    if (stream.finished) {
+        // A partial list would replace the one which is shown
+        if (!hasStreamError(stream)) {
+            emit finishedParsingProjectList(stream.list);
+        }
+    } else if (stream.list.size() >= qMax(firstProjectBatch, 2 * stream.emitted)) {
+        // Each partial list is twice as long as the previous one, so
+        // receivers which rebuild what they show do linear work overall
+        stream.emitted = stream.list.size();
+        emit projectsFetched(stream.list);
+    }
+}
+
+void OBSXmlReader::parseProjectEntries(QXmlStreamReader &xml, const QString &userHome, QStringList &list)
+{
+    while (readNext(xml)) {
+        if (xml.isStartElement() && OBSXmlToken::fromName(xml.name()) == OBSXmlToken::Entry) {
+            QXmlStreamAttributes attrib = xml.attributes();
+            QString entry = attrib.value("name").toString();
+            if (!userHome.isEmpty()) {
+                if (entry.startsWith(userHome)) {
+                    list.append(entry);
+                }
+                if (!entry.startsWith("home")) {
                     list.append(entry);
-                    emit projectFetched(entry);
                 }
+            } else {
+                list.append(entry);
             }
         } // end entry
 
     } // end while
-
-    if (xml.hasError()) {
-        qDebug() << Q_FUNC_INFO << "Error parsing XML!" << xml.errorString();
-    }
-
-    emit finishedParsingProjectList(list);
 }
 
-void OBSXmlReader::parsePrjMetaConfig(const QString &data)
+void OBSXmlReader::parsePrjMetaConfig(const QByteArray &data)
 {
     QXmlStreamReader xml(data);
     QSharedPointer<OBSPrjMetaConfig> prjMetaConfig;
@@ -134,7 +217,7 @@ void OBSXmlReader::parsePrjMetaConfig(const QString &data)
     emit finishedParsingProjectMetaConfig(prjMetaConfig);
 }
 
-void OBSXmlReader::parsePkgMetaConfig(const QString &data)
+void OBSXmlReader::parsePkgMetaConfig(const QByteArray &data)
 {
     QXmlStreamReader xml(data);
     QSharedPointer<OBSPkgMetaConfig> pkgMetaConfig;
@@ -165,7 +248,7 @@ void OBSXmlReader::parsePkgMetaConfig(const QString &data)
     emit finishedParsingPackageMetaConfig(pkgMetaConfig);
 }
 
-void OBSXmlReader::parsePackageList(const QString &data)
+void OBSXmlReader::parsePackageList(const QByteArray &data)
 {
     QXmlStreamReader xml(data);
     QStringList list = parseList(xml);
@@ -174,46 +257,50 @@ void OBSXmlReader::parsePackageList(const QString &data)
 
 void OBSXmlReader::parseStatus(QXmlStreamReader &xml, QSharedPointer<OBSStatus> status)
 {
-    if (xml.name().toString() == "status") {
-        if (xml.isStartElement()) {
-            QXmlStreamAttributes attrib = xml.attributes();
-            if (attrib.hasAttribute("package")) {
-                status->setPackage(attrib.value("package").toString());
-            }
-            status->setCode(attrib.value("code").toString());
-        }
-    } // end status
+    parseStatus(xml, OBSXmlToken::fromName(xml.name()), status);
+}
 
-    if (xml.name().toString() == "summary" && xml.isStartElement()) {
+void OBSXmlReader::parseStatus(QXmlStreamReader &xml, OBSXmlToken::Name token, QSharedPointer<OBSStatus> status)
+{
+    if (!xml.isStartElement()) {
+        return;
+    }
+
+    switch (token) {
+    case OBSXmlToken::Status: {
+        QXmlStreamAttributes attrib = xml.attributes();
+        if (attrib.hasAttribute("package")) {
+            status->setPackage(attrib.value("package").toString());
+        }
+        status->setCode(attrib.value("code").toString());
+        break;
+    }
+    case OBSXmlToken::Summary:
         xml.readNext();
         status->setSummary(xml.text().toString());
-        // If user doesn't exist, return
-        if (xml.text().toString().startsWith("Couldn't find User with login")) {
-            return;
-        }
-    } // end summary
-
-    if (xml.name().toString() == "details" && xml.isStartElement()) {
+        break;
+    case OBSXmlToken::Details:
         xml.readNext();
         status->setDetails(xml.text().toString());
-    } // end details
-
-    if (xml.name().toString() == "data" && xml.isStartElement()) {
-        if (xml.isStartElement()) {
-            QXmlStreamAttributes attrib = xml.attributes();
-            if (attrib.hasAttribute("name")) {
-                xml.readNext();
-                if (attrib.value("name").toString() == "targetproject") {
-                    status->setProject(xml.text().toString());
-                } else if (attrib.value("name").toString() == "targetpackage") {
-                    status->setPackage(xml.text().toString());
-                }
+        break;
+    case OBSXmlToken::Data: {
+        QXmlStreamAttributes attrib = xml.attributes();
+        if (attrib.hasAttribute("name")) {
+            xml.readNext();
+            if (attrib.value("name") == QLatin1String("targetproject")) {
+                status->setProject(xml.text().toString());
+            } else if (attrib.value("name") == QLatin1String("targetpackage")) {
+                status->setPackage(xml.text().toString());
             }
         }
-    } // end data
+        break;
+    }
+    default:
+        break;
+    }
 }
 
-void OBSXmlReader::parseBuildStatus(const QString &data)
+void OBSXmlReader::parseBuildStatus(const OBSParseContext &context, const QByteArray &data)
 {
     QXmlStreamReader xml(data);
     QSharedPointer<OBSStatus> status(new OBSStatus());
@@ -227,10 +314,11 @@ void OBSXmlReader::parseBuildStatus(const QString &data)
         qDebug() << Q_FUNC_INFO << "Error parsing XML!" << xml.errorString();
         return;
     }
-    emit finishedParsingPackage(status, row);
+    emit finishedParsingPackage(status, context.row);
 }
 
-QSharedPointer<OBSStatus> OBSXmlReader::parseNotFoundStatus(const QString &data)
+// Status of any reply, e.g. the _status of a build
+QSharedPointer<OBSStatus> OBSXmlReader::parseStatus(const QByteArray &data)
 {
     QXmlStreamReader xml(data);
     QSharedPointer<OBSStatus> status(new OBSStatus());
@@ -246,58 +334,139 @@ QSharedPointer<OBSStatus> OBSXmlReader::parseNotFoundStatus(const QString &data)
     return status;
 }
 
-void OBSXmlReader::setPackageRow(int row)
+// The last job of a _jobhistory; the source, build count and end time identify it
+QString OBSXmlReader::parseBuildJob(const QByteArray &data)
+{
+    QXmlStreamReader xml(data);
+    QString job;
+
+    while (!xml.atEnd() && !xml.hasError()) {
+        xml.readNext();
+        if (xml.isStartElement() && OBSXmlToken::fromName(xml.name()) == OBSXmlToken::JobHist) {
+            QXmlStreamAttributes attrib = xml.attributes();
+            job = QString("%1/%2/%3").arg(attrib.value("srcmd5").toString(), attrib.value("bcnt").toString(),
+                                          attrib.value("endtime").toString());
+        }
+    } // end while
+
+    if (xml.hasError()) {
+        qDebug() << Q_FUNC_INFO << "Error parsing XML!" << xml.errorString();
+        return QString();
+    }
+    return job;
+}
+
+QSharedPointer<OBSStatus> OBSXmlReader::parseNotFoundStatus(const QByteArray &data)
 {
-    this->row = row;
+    return parseStatus(data);
 }
 
-void OBSXmlReader::parseResultList(const QString &data)
+void OBSXmlReader::parseResultList(const QByteArray &data)
 {
     qDebug() << Q_FUNC_INFO;
 
     QXmlStreamReader xml(data);
-    QList<QSharedPointer<OBSResult>> resultList;
-    QSharedPointer<OBSResult> result;
-    QSharedPointer<OBSStatus> status;
+    OBSResultSet resultSet;
+    QString state;
 
-    while (!xml.atEnd() && !xml.hasError()) {
-        xml.readNext();
-        if (xml.isStartElement()) {
+    if (parseResultSet(xml, resultSet, state)) {
+        emit finishedParsingResults(resultSet);
+        emit finishedParsingResultList(resultSet);
+    }
+}
 
-            if (xml.name().toString() == "resultlist") {
-                xml.readNextStartElement();
-            }
+void OBSXmlReader::parseResultListStream(OBSXmlStream &stream)
+{
+    feedStream(stream, "</result>");
+    OBSResultSet resultSet;
+    parseResultSet(stream.xml, resultSet, stream.state);
+    bool error = hasStreamError(stream);
+
+    if (!error && !resultSet.isEmpty()) {
+        stream.resultSet.append(resultSet);
+        emit finishedParsingResults(resultSet);
+    }
+    // Also on errors, receivers wait for it. The list is empty then, so
+    // that the results which are missing aren't taken as removed
+    if (stream.finished) {
+        OBSResultSet resultList = error ? OBSResultSet() : stream.resultSet;
+        emit finishedParsingResultList(resultList);
+        // Only lists which aren't filtered (e.g. by package) have all the project results
+        if (!stream.context.project.isEmpty()) {
+            emit finishedParsingProjectResultList(stream.context.project, resultList,
+                                                  error ? QString() : stream.state);
+        }
+    }
+}
 
-            if (xml.name().toString() == "result") {
-                result = QSharedPointer<OBSResult>(new OBSResult());
-                QXmlStreamAttributes attrib = xml.attributes();
-                result->setProject(attrib.value("project").toString());
-                result->setRepository(attrib.value("repository").toString());
-                result->setArch(attrib.value("arch").toString());
-                result->setCode(attrib.value("code").toString());
-                result->setState(attrib.value("state").toString());
-                resultList.append(result);
-            }
+void OBSXmlReader::parseBuildResultsStream(OBSXmlStream &stream)
+{
+    feedStream(stream, "</result>");
+    OBSResultSet resultSet;
+    parseResultSet(stream.xml, resultSet, stream.state);
 
-            if (xml.name().toString() == "status") {
-                status = QSharedPointer<OBSStatus>(new OBSStatus());
-                result->appendStatus(status);
-            }
+    if (!resultSet.isEmpty()) {
+        emit finishedParsingBuildResults(stream.context.project, resultSet, stream.context.token);
+    }
+    // Also on errors, receivers wait for it to complete their rows
+    if (stream.finished) {
+        hasStreamError(stream);
+        emit finishedParsingBuildResultList(stream.context.project, stream.context.token);
+    }
+}
 
-            parseStatus(xml, status);
-        }
+// The state is empty if the reply cannot be parsed
+void OBSXmlReader::parseWatchedResults(const QString &resource, const QByteArray &data)
+{
+    QXmlStreamReader xml(data);
+    OBSResultSet resultSet;
+    QString state;
 
-        if (xml.name().toString() == "result" && xml.isEndElement()) {
-            emit finishedParsingResult(result);
+    if (!parseResultSet(xml, resultSet, state)) {
+        resultSet.clear();
+        state.clear();
+    }
+    emit finishedParsingWatchedResults(resource, resultSet, state);
+}
+
+bool OBSXmlReader::parseResultSet(QXmlStreamReader &xml, OBSResultSet &resultSet, QString &state)
+{
+    while (readNext(xml)) {
+        if (!xml.isStartElement()) {
+            continue;
         }
 
-        if (xml.name().toString() == "resultlist" && xml.isEndElement()) {
-            emit finishedParsingResultList(resultList);
+        switch (OBSXmlToken::fromName(xml.name())) {
+        case OBSXmlToken::ResultList:
+            state = xml.attributes().value("state").toString();
+            break;
+        case OBSXmlToken::Result: {
+            QXmlStreamAttributes attrib = xml.attributes();
+            resultSet.appendResult(attrib.value("project"), attrib.value("repository"),
+                                   attrib.value("arch"), attrib.value("state"));
+            break;
+        }
+        case OBSXmlToken::Status: {
+            QXmlStreamAttributes attrib = xml.attributes();
+            resultSet.appendStatus(attrib.value("package"), attrib.value("code"));
+            break;
+        }
+        case OBSXmlToken::Details:
+            xml.readNext();
+            resultSet.appendDetails(xml.text().toString());
+            break;
+        default:
+            break;
         }
+    } // end while
+
+    if (xml.hasError() && xml.error() != QXmlStreamReader::PrematureEndOfDocumentError) {
+        qDebug() << Q_FUNC_INFO << "Error parsing XML!" << xml.errorString();
     }
+    return !xml.hasError();
 }
 
-void OBSXmlReader::parseRequestStatus(const QString &data)
+void OBSXmlReader::parseRequestStatus(const QByteArray &data)
 {
     QXmlStreamReader xml(data);
     QSharedPointer<OBSStatus> status(new OBSStatus());
@@ -315,24 +484,26 @@ void OBSXmlReader::parseRequestStatus(const QString &data)
     emit finishedParsingRequestStatus(status);
 }
 
-void OBSXmlReader::parsePackageSearch(const QString &data)
+void OBSXmlReader::parsePackageSearch(const QByteArray &data)
 {
     QXmlStreamReader xml(data);
+    OBSParseContext context;
     QStringList results;
 
     while (!xml.atEnd() && !xml.hasError()) {
         xml.readNext();
+        OBSXmlToken::Name token = OBSXmlToken::fromName(xml.name());
 
-        parseCollection(xml);
+        parseCollection(xml, token, context);
 
-        if (xml.name().toString() == "package" && xml.isStartElement()) {
+        if (token == OBSXmlToken::Package && xml.isStartElement()) {
             QXmlStreamAttributes attrib = xml.attributes();
             QString name = attrib.value("name").toString();
             QString project = attrib.value("project").toString();
             results.append(project + "/" + name);
         }
 
-        if (xml.name().toString() == "collection" && xml.isEndElement()) {
+        if (token == OBSXmlToken::Collection && xml.isEndElement()) {
             emit finishedParsingPackageSearch(results);
         }
     }
@@ -343,34 +514,20 @@ void OBSXmlReader::parsePackageSearch(const QString &data)
     }
 }
 
-void OBSXmlReader::parseRequests(const QString &project, const QString &package, const QString &data)
+void OBSXmlReader::parseRequestsStream(OBSXmlStream &stream)
 {
-    QXmlStreamReader xml(data);
-    QSharedPointer<OBSRequest> request;
-
-    while (!xml.atEnd() && !xml.hasError()) {
-        xml.readNext();
-
-        parseCollection(xml);
-
-        if (xml.name().toString() == "request") {
-                request = parseRequest(xml);
-        }
-
-        if (xml.name().toString() == "request" && xml.isEndElement()) {
-            emit finishedParsingRequest(request);
-        }
+    QList<QSharedPointer<OBSRequest>> requestList = parseRequestList(stream);
+    if (!requestList.isEmpty()) {
+        emit finishedParsingRequests(requestList);
     }
-
-    if (xml.hasError()) {
-        qDebug() << Q_FUNC_INFO << "Error parsing XML!" << xml.errorString();
-        return;
+    // Also on errors, receivers wait for it
+    if (stream.finished) {
+        hasStreamError(stream);
+        emit finishedParsingRequestList(stream.context.project, stream.context.package);
     }
-
-    emit finishedParsingRequestList(project, package);
 }
 
-void OBSXmlReader::parseBranchPackage(const QString &data)
+void OBSXmlReader::parseBranchPackage(const QByteArray &data)
 {
     qDebug() << Q_FUNC_INFO;
     qDebug() << data;
@@ -390,7 +547,7 @@ void OBSXmlReader::parseBranchPackage(const QString &data)
     emit finishedParsingBranchPackage(status);
 }
 
-void OBSXmlReader::parseLinkPackage(const QString &project, const QString &package, const QString &data)
+void OBSXmlReader::parseLinkPackage(const QString &project, const QString &package, const QByteArray &data)
 {
     qDebug() << Q_FUNC_INFO;
     QXmlStreamReader xml(data);
@@ -411,7 +568,7 @@ void OBSXmlReader::parseLinkPackage(const QString &project, const QString &packa
     emit finishedParsingLinkPkgRevision(revision);
 }
 
-void OBSXmlReader::parseCopyPackage(const QString &project, const QString &package, const QString &data)
+void OBSXmlReader::parseCopyPackage(const QString &project, const QString &package, const QByteArray &data)
 {
     qDebug() << Q_FUNC_INFO;
     QXmlStreamReader xml(data);
@@ -432,7 +589,7 @@ void OBSXmlReader::parseCopyPackage(const QString &project, const QString &packa
     emit finishedParsingCopyPkgRevision(revision);
 }
 
-void OBSXmlReader::parseCreateRequest(const QString &data)
+void OBSXmlReader::parseCreateRequest(const QByteArray &data)
 {
     qDebug() << Q_FUNC_INFO;
     QXmlStreamReader xml(data);
@@ -453,7 +610,7 @@ void OBSXmlReader::parseCreateRequest(const QString &data)
     emit finishedParsingCreateRequest(request);
 }
 
-void OBSXmlReader::parseCreateRequestStatus(const QString &data)
+void OBSXmlReader::parseCreateRequestStatus(const QByteArray &data)
 {
     qDebug() << Q_FUNC_INFO;
     QXmlStreamReader xml(data);
@@ -472,7 +629,7 @@ void OBSXmlReader::parseCreateRequestStatus(const QString &data)
     emit finishedParsingCreateRequestStatus(status);
 }
 
-void OBSXmlReader::parseCreateProject(const QString &project, const QString &data)
+void OBSXmlReader::parseCreateProject(const QString &project, const QByteArray &data)
 {
     qDebug() << Q_FUNC_INFO;
     QXmlStreamReader xml(data);
@@ -492,7 +649,7 @@ void OBSXmlReader::parseCreateProject(const QString &project, const QString &dat
     emit finishedParsingCreatePrjStatus(status);
 }
 
-void OBSXmlReader::parseCreatePackage(const QString &project, const QString &package,const QString &data)
+void OBSXmlReader::parseCreatePackage(const QString &project, const QString &package,const QByteArray &data)
 {
     qDebug() << Q_FUNC_INFO;
     QXmlStreamReader xml(data);
@@ -513,7 +670,7 @@ void OBSXmlReader::parseCreatePackage(const QString &project, const QString &pac
     emit finishedParsingCreatePkgStatus(status);
 }
 
-void OBSXmlReader::parseUploadFile(const QString &project, const QString &package, const QString &file, const QString &data)
+void OBSXmlReader::parseUploadFile(const QString &project, const QString &package, const QString &file, const QByteArray &data)
 {
     qDebug() << Q_FUNC_INFO;
     QXmlStreamReader xml(data);
@@ -535,7 +692,7 @@ void OBSXmlReader::parseUploadFile(const QString &project, const QString &packag
     emit finishedParsingUploadFileRevision(revision);
 }
 
-void OBSXmlReader::parseDeleteProject(const QString &project, const QString &data)
+void OBSXmlReader::parseDeleteProject(const QString &project, const QByteArray &data)
 {
     qDebug() << Q_FUNC_INFO;
     QXmlStreamReader xml(data);
@@ -555,7 +712,7 @@ void OBSXmlReader::parseDeleteProject(const QString &project, const QString &dat
     emit finishedParsingDeletePrjStatus(status);
 }
 
-void OBSXmlReader::parseDeletePackage(const QString &project, const QString &package, const QString &data)
+void OBSXmlReader::parseDeletePackage(const QString &project, const QString &package, const QByteArray &data)
 {
     qDebug() << Q_FUNC_INFO;
     QXmlStreamReader xml(data);
@@ -576,7 +733,7 @@ void OBSXmlReader::parseDeletePackage(const QString &project, const QString &pac
     emit finishedParsingDeletePkgStatus(status);
 }
 
-void OBSXmlReader::parseDeleteFile(const QString &project, const QString &package, const QString &fileName, const QString &data)
+void OBSXmlReader::parseDeleteFile(const QString &project, const QString &package, const QString &fileName, const QByteArray &data)
 {
     qDebug() << Q_FUNC_INFO;
     QXmlStreamReader xml(data);
@@ -600,237 +757,252 @@ void OBSXmlReader::parseDeleteFile(const QString &project, const QString &packag
 
 void OBSXmlReader::parseRevision(QXmlStreamReader &xml, QSharedPointer<OBSRevision> revision)
 {
-    if (xml.name().toString() == "revision") {
-        QXmlStreamAttributes attrib = xml.attributes();
-        revision->setRev(attrib.value("rev").toUInt());
+    parseRevision(xml, OBSXmlToken::fromName(xml.name()), revision);
+}
+
+void OBSXmlReader::parseRevision(QXmlStreamReader &xml, OBSXmlToken::Name token, QSharedPointer<OBSRevision> revision)
+{
+    if (!xml.isStartElement()) {
+        return;
     }
-    if (xml.name().toString() == "version") {
+
+    switch (token) {
+    case OBSXmlToken::Revision:
+        revision->setRev(xml.attributes().value("rev").toUInt());
+        break;
+    case OBSXmlToken::Version:
         xml.readNext();
         revision->setVersion(xml.text().toString());
-    }
-    if (xml.name().toString() == "time") {
+        break;
+    case OBSXmlToken::Time:
         xml.readNext();
         revision->setTime(xml.text().toUInt());
-    }
-    if (xml.name().toString() == "user") {
+        break;
+    case OBSXmlToken::User:
         xml.readNext();
         revision->setUser(xml.text().toString());
-    }
-    if (xml.name().toString() == "comment") {
+        break;
+    case OBSXmlToken::Comment:
         xml.readNext();
         revision->setComment(xml.text().toString());
+        break;
+    default:
+        break;
     }
 }
 
-void OBSXmlReader::parseRevisionList(const QString &project, const QString &package, const QString &data)
+void OBSXmlReader::parseRevisionList(const QString &project, const QString &package, const QByteArray &data)
 {
     QXmlStreamReader xml(data);
+    QList<QSharedPointer<OBSRevision>> revisionList;
     QSharedPointer<OBSRevision> revision;
 
     while (!xml.atEnd() && !xml.hasError()) {
         xml.readNext();
-        if (xml.isStartElement()) {
-            if (xml.name().toString() == "revisionlist") {
-                xml.readNextStartElement();
-            }
+        OBSXmlToken::Name token = OBSXmlToken::fromName(xml.name());
 
-            if (xml.name().toString() == "revision") {
+        if (xml.isStartElement()) {
+            if (token == OBSXmlToken::Revision) {
                 revision = QSharedPointer<OBSRevision>(new OBSRevision());
                 revision->setProject(project);
                 revision->setPackage(package);
             }
-            parseRevision(xml, revision);
-        }
-
-        if (xml.name().toString() == "revision" && xml.isEndElement()) {
-            emit finishedParsingRevision(revision);
+            if (revision) {
+                parseRevision(xml, token, revision);
+            }
+        } else if (xml.isEndElement() && token == OBSXmlToken::Revision) {
+            revisionList.append(revision);
         }
     }
+    emit finishedParsingRevisions(revisionList);
     emit finishedParsingRevisionList(project, package);
 }
 
-void OBSXmlReader::parseLatestRevision(const QString &project, const QString &package, const QString &data)
+void OBSXmlReader::parseLatestRevision(const QString &project, const QString &package, const QByteArray &data)
 {
     QXmlStreamReader xml(data);
     QSharedPointer<OBSRevision> revision = QSharedPointer<OBSRevision>(new OBSRevision());
 
     while (!xml.atEnd() && !xml.hasError()) {
         xml.readNext();
+        OBSXmlToken::Name token = OBSXmlToken::fromName(xml.name());
+
         if (xml.isStartElement()) {
-            if (xml.name().toString() == "revision") {
+            if (token == OBSXmlToken::Revision) {
                 revision->setProject(project);
                 revision->setPackage(package);
             }
-            parseRevision(xml, revision);
-        }
-
-        if (xml.name().toString() == "revisionlist" && xml.isEndElement()) {
+            parseRevision(xml, token, revision);
+        } else if (xml.isEndElement() && token == OBSXmlToken::RevisionList) {
             emit finishedParsingLatestRevision(revision);
         }
     }
 }
 
-void OBSXmlReader::parseCollection(QXmlStreamReader &xml)
+void OBSXmlReader::feedStream(OBSXmlStream &stream, const QByteArray &boundary)
 {
-    if (xml.name().toString() == "collection") {
-        if (xml.isStartElement()) {
-            QXmlStreamAttributes attrib = xml.attributes();
-            QStringView matches = attrib.value("matches");
-            QStringView code = attrib.value("code");
-            requestNumber = matches.toString();
-
-            qDebug() << Q_FUNC_INFO << "Collection matches:" << requestNumber;
+    qsizetype end = stream.buffer.size();
+    if (!stream.finished) {
+        end = stream.buffer.lastIndexOf(boundary);
+        if (end == -1) {
+            return;
         }
-    } // collection
+        end += boundary.size();
+    }
+    stream.xml.addData(stream.buffer.left(end));
+    stream.buffer.remove(0, end);
 }
 
-void OBSXmlReader::parseIncomingRequests(const QString &data)
+bool OBSXmlReader::hasStreamError(const OBSXmlStream &stream)
 {
-    QXmlStreamReader xml(data);
-    QSharedPointer<OBSRequest> request;
-
-    while (!xml.atEnd() && !xml.hasError()) {
-        xml.readNext();
-
-        parseCollection(xml);
-
-        if (xml.name().toString() == "request" && xml.isStartElement()) {
-            request = parseRequest(xml);
-            if (xml.name().toString() == "request" && xml.isEndElement()) {
-                emit finishedParsingIncomingRequest(request);
-            }
-        } // request
-
-        if (xml.name().toString() == "collection" && xml.isEndElement()) {
-            emit finishedParsingIncomingRequestList();
-        }
+    const QXmlStreamReader &xml = stream.xml;
+    // Running out of data is only an error once everything has been received
+    if (!xml.hasError() || (xml.error() == QXmlStreamReader::PrematureEndOfDocumentError && !stream.finished)) {
+        return false;
     }
+    qDebug() << Q_FUNC_INFO << "Error parsing XML!" << xml.errorString();
+    return true;
+}
 
-    if (xml.hasError()) {
-        qDebug() << Q_FUNC_INFO << "Error parsing XML!" << xml.errorString();
-        return;
+bool OBSXmlReader::readNext(QXmlStreamReader &xml)
+{
+    // readNext() resumes after a premature end once more data is added
+    if (xml.hasError() ? xml.error() != QXmlStreamReader::PrematureEndOfDocumentError : xml.atEnd()) {
+        return false;
     }
+    xml.readNext();
+    return !xml.hasError();
 }
 
-void OBSXmlReader::parseOutgoingRequests(const QString &data)
+void OBSXmlReader::parseCollection(QXmlStreamReader &xml, OBSXmlToken::Name token, OBSParseContext &context)
 {
-    QXmlStreamReader xml(data);
-    QSharedPointer<OBSRequest> request;
-
-    while (!xml.atEnd() && !xml.hasError()) {
-        xml.readNext();
-
-        parseCollection(xml);
+    if (token == OBSXmlToken::Collection && xml.isStartElement()) {
+        QXmlStreamAttributes attrib = xml.attributes();
+        context.matches = attrib.value("matches").toInt();
 
-        if (xml.name().toString() == "request" && xml.isStartElement()) {
-            request = parseRequest(xml);
-            if (xml.name().toString() == "request" && xml.isEndElement()) {
-                emit finishedParsingOutgoingRequest(request);
-            }
-        } // request
+        qDebug() << Q_FUNC_INFO << "Collection matches:" << context.matches;
+    } // collection
+}
 
-        if (xml.name().toString() == "collection" && xml.isEndElement()) {
-            emit finishedParsingOutgoingRequestList();
-        }
+void OBSXmlReader::parseIncomingRequestsStream(OBSXmlStream &stream)
+{
+    QList<QSharedPointer<OBSRequest>> requestList = parseRequestList(stream);
+    if (!requestList.isEmpty()) {
+        emit finishedParsingIncomingRequests(requestList);
+    }
+    if (stream.finished) {
+        hasStreamError(stream);
+        emit finishedParsingIncomingRequestList(stream.context.matches);
+    }
+}
 
+void OBSXmlReader::parseOutgoingRequestsStream(OBSXmlStream &stream)
+{
+    QList<QSharedPointer<OBSRequest>> requestList = parseRequestList(stream);
+    if (!requestList.isEmpty()) {
+        emit finishedParsingOutgoingRequests(requestList);
+    }
+    if (stream.finished) {
+        hasStreamError(stream);
+        emit finishedParsingOutgoingRequestList(stream.context.matches);
     }
+}
 
-    if (xml.hasError()) {
-        qDebug() << Q_FUNC_INFO << "Error parsing XML!" << xml.errorString();
-        return;
+void OBSXmlReader::parseDeclinedRequestsStream(OBSXmlStream &stream)
+{
+    QList<QSharedPointer<OBSRequest>> requestList = parseRequestList(stream);
+    if (!requestList.isEmpty()) {
+        emit finishedParsingDeclinedRequests(requestList);
+    }
+    if (stream.finished) {
+        hasStreamError(stream);
+        emit finishedParsingDeclinedRequestList(stream.context.matches);
     }
 }
 
-void OBSXmlReader::parseDeclinedRequests(const QString &data)
+QList<QSharedPointer<OBSRequest>> OBSXmlReader::parseRequestList(OBSXmlStream &stream)
 {
-    QXmlStreamReader xml(data);
-    QSharedPointer<OBSRequest> request;
+    feedStream(stream, "</request>");
+    QXmlStreamReader &xml = stream.xml;
+    QList<QSharedPointer<OBSRequest>> requestList;
 
-    while (!xml.atEnd() && !xml.hasError()) {
-        xml.readNext();
+    while (readNext(xml)) {
+        OBSXmlToken::Name token = OBSXmlToken::fromName(xml.name());
 
-        parseCollection(xml);
+        parseCollection(xml, token, stream.context);
 
-        if (xml.name().toString() == "request" && xml.isStartElement()) {
-            request = parseRequest(xml);
-            if (xml.name().toString() == "request" && xml.isEndElement()) {
-                emit finishedParsingDeclinedRequest(request);
+        if (token == OBSXmlToken::Request && xml.isStartElement()) {
+            QSharedPointer<OBSRequest> request = parseRequest(xml);
+            if (xml.isEndElement()) {
+                requestList.append(request);
             }
         } // request
-
-        if (xml.name().toString() == "collection" && xml.isEndElement()) {
-            emit finishedParsingDeclinedRequestList();
-        }
-
-    }
-
-    if (xml.hasError()) {
-        qDebug() << Q_FUNC_INFO << "Error parsing XML!" << xml.errorString();
-        return;
     }
+    return requestList;
 }
 
 QSharedPointer<OBSRequest> OBSXmlReader::parseRequest(QXmlStreamReader &xml)
 {
     QSharedPointer<OBSRequest> request;
 
-    if (xml.name().toString() == "request") {
-        if (xml.isStartElement()) {
-            request = QSharedPointer<OBSRequest>(new OBSRequest());
-            QXmlStreamAttributes attrib = xml.attributes();
-            request->setId(attrib.value("id").toString());
-            request->setCreator(attrib.value("creator").toString());
-        }
+    if (OBSXmlToken::fromName(xml.name()) == OBSXmlToken::Request && xml.isStartElement()) {
+        request = QSharedPointer<OBSRequest>(new OBSRequest());
+        QXmlStreamAttributes attrib = xml.attributes();
+        request->setId(attrib.value("id").toString());
+        request->setCreator(attrib.value("creator").toString());
     } // request
 
-    while (!(xml.name().toString() == "request" && xml.isEndElement())) {
+    while (!xml.atEnd() && !xml.hasError()) {
         xml.readNext();
+        OBSXmlToken::Name token = OBSXmlToken::fromName(xml.name());
 
-        if (xml.name().toString() == "action")  {
-            if (xml.isStartElement()) {
-                QXmlStreamAttributes attrib = xml.attributes();
-                request->setActionType(attrib.value("type").toString());
-            }
-        } // action
-
-        if (xml.name().toString() == "source") {
-            if (xml.isStartElement()) {
-                QXmlStreamAttributes attrib = xml.attributes();
-                request->setSourceProject(attrib.value("project").toString());
-                request->setSourcePackage(attrib.value("package").toString());
-            }
-        } // source
-
-        if (xml.name().toString() == "target") {
-            if (xml.isStartElement()) {
-                QXmlStreamAttributes attrib = xml.attributes();
-                request->setTargetProject(attrib.value("project").toString());
-                request->setTargetPackage(attrib.value("package").toString());
-            }
-        } // target
+        if (token == OBSXmlToken::Request && xml.isEndElement()) {
+            break;
+        }
 
-        if (xml.name().toString() == "state") {
-            if (xml.isStartElement()) {
-                QXmlStreamAttributes attrib = xml.attributes();
-                request->setState(attrib.value("name").toString());
-                request->setRequester(attrib.value("who").toString());
-                QString date = attrib.value("when").toString();
-                // Replace the "T" (as in 2015-03-13T20:01:33)
-                date.replace(10, 1, " ");
-                request->setDate(date);
-            }
-        } // state
+        if (!xml.isStartElement()) {
+            continue;
+        }
 
-        if (xml.name().toString() == "description") {
-            if (xml.isStartElement()) {
-                xml.readNext();
-                request->setDescription(xml.text().toString());
-                // if tag is not empty (ie: <description/>), read next start element
-                if (!xml.text().isEmpty()) {
-                    xml.readNextStartElement();
-                }
+        switch (token) {
+        case OBSXmlToken::Action: {
+            QXmlStreamAttributes attrib = xml.attributes();
+            request->setActionType(attrib.value("type").toString());
+            break;
+        }
+        case OBSXmlToken::Source: {
+            QXmlStreamAttributes attrib = xml.attributes();
+            request->setSourceProject(attrib.value("project").toString());
+            request->setSourcePackage(attrib.value("package").toString());
+            break;
+        }
+        case OBSXmlToken::Target: {
+            QXmlStreamAttributes attrib = xml.attributes();
+            request->setTargetProject(attrib.value("project").toString());
+            request->setTargetPackage(attrib.value("package").toString());
+            break;
+        }
+        case OBSXmlToken::State: {
+            QXmlStreamAttributes attrib = xml.attributes();
+            request->setState(attrib.value("name").toString());
+            request->setRequester(attrib.value("who").toString());
+            QString date = attrib.value("when").toString();
+            // Replace the "T" (as in 2015-03-13T20:01:33)
+            date.replace(10, 1, " ");
+            request->setDate(date);
+            break;
+        }
+        case OBSXmlToken::Description:
+            xml.readNext();
+            request->setDescription(xml.text().toString());
+            // if tag is not empty (ie: <description/>), read next start element
+            if (!xml.text().isEmpty()) {
+                xml.readNextStartElement();
             }
-        } // description
+            break;
+        default:
+            break;
+        }
     }
     return request;
 }
@@ -843,29 +1015,19 @@ QStringList OBSXmlReader::parseList(QXmlStreamReader &xml)
 
         xml.readNext();
 
-        if (xml.name().toString() == "entry") {
-            if (xml.isStartElement()) {
-                QXmlStreamAttributes attrib = xml.attributes();
-
-                if (attrib.value("code").toString() == "unregistered_ichain_user") {
-                    qDebug() << Q_FUNC_INFO << "Unregistered username!";
-                } else {
-                    list.append(attrib.value("name").toString());
-                }
-            }
-        } // end entry
+        if (xml.isStartElement()) {
+            OBSXmlToken::Name token = OBSXmlToken::fromName(xml.name());
 
-        if (xml.name().toString() == "repository") {
-            if (xml.isStartElement()) {
+            if (token == OBSXmlToken::Entry || token == OBSXmlToken::Repository) {
                 QXmlStreamAttributes attrib = xml.attributes();
 
-                if (attrib.value("code").toString() == "unregistered_ichain_user") {
+                if (attrib.value("code") == QLatin1String("unregistered_ichain_user")) {
                     qDebug() << Q_FUNC_INFO << "Unregistered username!";
                 } else {
                     list.append(attrib.value("name").toString());
                 }
             }
-        } // end repository
+        } // end entry/repository
 
     } // end while
 
@@ -993,34 +1155,33 @@ QSharedPointer<OBSDistribution> OBSXmlReader::parseDistribution(QXmlStreamReader
     return distribution;
 }
 
-void OBSXmlReader::parseFileList(const QString &project, const QString &package, const QString &data)
+void OBSXmlReader::parseFileList(const QString &project, const QString &package, const QByteArray &data)
 {
     qDebug() << Q_FUNC_INFO;
     QXmlStreamReader xml(data);
+    QList<QSharedPointer<OBSFile>> fileList;
 
     while (!xml.atEnd() && !xml.hasError()) {
 
         xml.readNext();
 
-        if (xml.name().toString() == "entry") {
-            QSharedPointer<OBSFile> file;
-            if (xml.isStartElement()) {
-                QXmlStreamAttributes attrib = xml.attributes();
-                file = QSharedPointer<OBSFile>(new OBSFile());
-                file->setProject(project);
-                file->setPackage(package);
-                file->setName(attrib.value("name").toString());
-                file->setSize(attrib.value("size").toString());
-                file->setLastModified(attrib.value("mtime").toString());
-                emit finishedParsingFile(file);
-            }
+        if (xml.isStartElement() && OBSXmlToken::fromName(xml.name()) == OBSXmlToken::Entry) {
+            QXmlStreamAttributes attrib = xml.attributes();
+            QSharedPointer<OBSFile> file(new OBSFile());
+            file->setProject(project);
+            file->setPackage(package);
+            file->setName(attrib.value("name").toString());
+            file->setSize(attrib.value("size").toString());
+            file->setLastModified(attrib.value("mtime").toString());
+            fileList.append(file);
         } // end entry
 
     } // end while
+    emit finishedParsingFiles(fileList);
     emit finishedParsingFileList(project, package);
 }
 
-void OBSXmlReader::parseLink(const QString &data)
+void OBSXmlReader::parseLink(const QByteArray &data)
 {
     qDebug() << Q_FUNC_INFO;
     QXmlStreamReader xml(data);
@@ -1048,7 +1209,7 @@ void OBSXmlReader::parseLink(const QString &data)
     emit finishedParsingLink(link);
 }
 
-void OBSXmlReader::parseAbout(const QString &data)
+void OBSXmlReader::parseAbout(const QByteArray &data)
 {
     QXmlStreamReader xml(data);
     QSharedPointer<OBSAbout> about(new OBSAbout());
@@ -1087,7 +1248,7 @@ void OBSXmlReader::parseAbout(const QString &data)
     emit finishedParsingAbout(about);
 }
 
-void OBSXmlReader::parsePerson(const QString &data)
+void OBSXmlReader::parsePerson(const QByteArray &data)
 {
     QXmlStreamReader xml(data);
     QSharedPointer<OBSPerson> person(new OBSPerson());
@@ -1142,7 +1303,7 @@ void OBSXmlReader::parsePerson(const QString &data)
     emit finishedParsingPerson(person);
 }
 
-void OBSXmlReader::parseUpdatePerson(const QString &data)
+void OBSXmlReader::parseUpdatePerson(const QByteArray &data)
 {
     qDebug() << Q_FUNC_INFO;
     QXmlStreamReader xml(data);
@@ -1161,7 +1322,7 @@ void OBSXmlReader::parseUpdatePerson(const QString &data)
     emit finishedParsingUpdatePerson(status);
 }
 
-void OBSXmlReader::parseDistributions(const QString &data)
+void OBSXmlReader::parseDistributions(const QByteArray &data)
 {
     QXmlStreamReader xml(data);
 
@@ -1183,7 +1344,7 @@ void OBSXmlReader::parseDistributions(const QString &data)
     }
 }
 
-QSharedPointer<OBSStatus> OBSXmlReader::parseError(const QString &data)
+QSharedPointer<OBSStatus> OBSXmlReader::parseError(const QByteArray &data)
 {
     QSharedPointer<OBSStatus> status(new OBSStatus());
     QXmlStreamReader xml(data);
@@ -1198,8 +1359,3 @@ QSharedPointer<OBSStatus> OBSXmlReader::parseError(const QString &data)
     }
     return status;
 }
-
-int OBSXmlReader::getRequestNumber()
-{
-    return requestNumber.toInt();
-}
@@ -24,10 +24,13 @@
 #include <QDesktopServices>
 #include <QCoreApplication>
 #include <QSharedPointer>
+#include <QThreadPool>
+#include <QMutex>
 #include "obsrequest.h"
 #include "obsfile.h"
 #include "obslink.h"
 #include "obsresult.h"
+#include "obsresultset.h"
 #include "obsrevision.h"
 #include "obsstatus.h"
 #include "obsabout.h"
@@ -35,6 +38,52 @@
 #include "obsprjmetaconfig.h"
 #include "obspkgmetaconfig.h"
 #include "obsdistribution.h"
+#include "obsxmltoken.h"
+
+/*
+ * State of a single reply while it is being parsed. Each reply gets
+ * its own context, so the reader itself holds no per-reply state and
+ * several replies can be parsed at the same time.
+ *
+ */
+struct OBSParseContext
+{
+    int row = -1;
+    QString project;
+    QString package;
+    int matches = 0;
+    QString userHome;
+    int token = 0;
+};
+
+class OBSXmlReader;
+
+/*
+ * State of a reply which is parsed while it is being received (see
+ * OBSXmlReader::parseStream()). Received data is queued in pending
+ * and handed to xml up to the end of the last complete item (e.g.
+ * </request>), so that items are always read from complete data.
+ * What has to be kept until the end of the reply is stored here too.
+ *
+ */
+struct OBSXmlStream
+{
+    typedef void (OBSXmlReader::*Parser)(OBSXmlStream &stream);
+    Parser parser = nullptr;
+    OBSParseContext context;
+    QXmlStreamReader xml;
+    QByteArray buffer;
+    bool finished = false;
+    QStringList list;
+    int emitted = 0;
+    OBSResultSet resultSet;
+    QString state;
+    QMutex parseMutex;
+    QMutex mutex;
+    QByteArray pending;
+    bool pendingFinished = false;
+    bool pendingFailed = false;
+};
 
 class OBSXmlReader : public QObject
 {
@@ -42,58 +91,95 @@ class OBSXmlReader : public QObject
 
 public:
     static OBSXmlReader *getInstance();
-    void addData(const QString &data);
-    void setPackageRow(int row);
-    void parseProjectList(const QString &userHome, const QString &data);
-    void parsePrjMetaConfig(const QString &data);
-    void parsePkgMetaConfig(const QString &data);
-    void parseBuildStatus(const QString &data);
-    QSharedPointer<OBSStatus> parseNotFoundStatus(const QString &data);
-    void parsePackageList(const QString &data);
-    void parseFileList(const QString &project, const QString &package, const QString &data);
-    void parseRevisionList(const QString &project, const QString &package, const QString &data);
-    void parseLatestRevision(const QString &project, const QString &package, const QString &data);
-    void parseLink(const QString &data);
-    void parseResultList(const QString &data);
-    void parseIncomingRequests(const QString &data);
-    void parseOutgoingRequests(const QString &data);
-    void parseDeclinedRequests(const QString &data);
-    void parseRequestStatus(const QString &data);
-    void parsePackageSearch(const QString &data);
-    void parseRequests(const QString &project, const QString &package, const QString &data);
-    void parseBranchPackage(const QString &data);
-    void parseLinkPackage(const QString &project, const QString &package, const QString &data);
-    void parseCopyPackage(const QString &project, const QString &package, const QString &data);
-    void parseCreateRequest(const QString &data);
-    void parseCreateRequestStatus(const QString &data);
-    void parseCreateProject(const QString &project, const QString &data);
-    void parseCreatePackage(const QString &package, const QString &project, const QString &data);
-    void parseUploadFile(const QString &project, const QString &package, const QString &file, const QString &data);
-    void parseDeleteProject(const QString &project, const QString &data);
-    void parseDeletePackage(const QString &project, const QString &package, const QString &data);
-    void parseDeleteFile(const QString &project, const QString &package, const QString &fileName, const QString &data);
-    int getRequestNumber();
-    void parseAbout(const QString &data);
-    void parsePerson(const QString &data);
-    void parseUpdatePerson(const QString &data);
-    void parseDistributions(const QString &data);
-    QSharedPointer<OBSStatus> parseError(const QString &data);
+
+/*
+ * Runs a parse* method on the parser thread pool. Results are emitted
+ * from the worker thread, so they reach receivers living in the GUI
+ * thread through queued connections. Arguments are copied.
+ *
+ */
+    template<typename... Params, typename... Args>
+    void parseInBackground(void (OBSXmlReader::*parser)(Params...), Args... args)
+    {
+        threadPool->start([this, parser, args...]() {
+            (this->*parser)(args...);
+        });
+    }
+/*
+ * Queues data received for a stream and parses it on the thread pool,
+ * in order. finished is set with the last data of the reply.
+ *
+ */
+    void parseStream(QSharedPointer<OBSXmlStream> stream, const QByteArray &data, bool finished);
+/*
+ * Ends a stream whose reply failed. Data which has not been parsed yet
+ * is dropped and the parser is run once more, so that it can close
+ * its list.
+ *
+ */
+    void abortStream(QSharedPointer<OBSXmlStream> stream);
+    void addData(const OBSParseContext &context, const QByteArray &data);
+    void parseProjectList(const QString &userHome, const QByteArray &data);
+    void parseProjectListStream(OBSXmlStream &stream);
+    void parsePrjMetaConfig(const QByteArray &data);
+    void parsePkgMetaConfig(const QByteArray &data);
+    void parseBuildStatus(const OBSParseContext &context, const QByteArray &data);
+    QSharedPointer<OBSStatus> parseStatus(const QByteArray &data);
+    QString parseBuildJob(const QByteArray &data);
+    QSharedPointer<OBSStatus> parseNotFoundStatus(const QByteArray &data);
+    void parsePackageList(const QByteArray &data);
+    void parseFileList(const QString &project, const QString &package, const QByteArray &data);
+    void parseRevisionList(const QString &project, const QString &package, const QByteArray &data);
+    void parseLatestRevision(const QString &project, const QString &package, const QByteArray &data);
+    void parseLink(const QByteArray &data);
+    void parseResultList(const QByteArray &data);
+    void parseResultListStream(OBSXmlStream &stream);
+    void parseBuildResultsStream(OBSXmlStream &stream);
+    void parseWatchedResults(const QString &resource, const QByteArray &data);
+    void parseIncomingRequestsStream(OBSXmlStream &stream);
+    void parseOutgoingRequestsStream(OBSXmlStream &stream);
+    void parseDeclinedRequestsStream(OBSXmlStream &stream);
+    void parseRequestStatus(const QByteArray &data);
+    void parsePackageSearch(const QByteArray &data);
+    void parseRequestsStream(OBSXmlStream &stream);
+    void parseBranchPackage(const QByteArray &data);
+    void parseLinkPackage(const QString &project, const QString &package, const QByteArray &data);
+    void parseCopyPackage(const QString &project, const QString &package, const QByteArray &data);
+    void parseCreateRequest(const QByteArray &data);
+    void parseCreateRequestStatus(const QByteArray &data);
+    void parseCreateProject(const QString &project, const QByteArray &data);
+    void parseCreatePackage(const QString &package, const QString &project, const QByteArray &data);
+    void parseUploadFile(const QString &project, const QString &package, const QString &file, const QByteArray &data);
+    void parseDeleteProject(const QString &project, const QByteArray &data);
+    void parseDeletePackage(const QString &project, const QString &package, const QByteArray &data);
+    void parseDeleteFile(const QString &project, const QString &package, const QString &fileName, const QByteArray &data);
+    void parseAbout(const QByteArray &data);
+    void parsePerson(const QByteArray &data);
+    void parseUpdatePerson(const QByteArray &data);
+    void parseDistributions(const QByteArray &data);
+    QSharedPointer<OBSStatus> parseError(const QByteArray &data);
 
 private:
     static OBSXmlReader *instance;
     OBSXmlReader();
+    QThreadPool *threadPool;
     void parseStatus(QXmlStreamReader &xml, QSharedPointer<OBSStatus> status);
-    int row;
+    void parseStatus(QXmlStreamReader &xml, OBSXmlToken::Name token, QSharedPointer<OBSStatus> status);
     void parseRevision(QXmlStreamReader &xml, QSharedPointer<OBSRevision> revision);
-    QList<QString> requestIdList;
-    QList<QString> oldRequestIdList;
-    void parseCollection(QXmlStreamReader &xml);
+    void parseRevision(QXmlStreamReader &xml, OBSXmlToken::Name token, QSharedPointer<OBSRevision> revision);
+    void parseCollection(QXmlStreamReader &xml, OBSXmlToken::Name token, OBSParseContext &context);
     QSharedPointer<OBSRequest> parseRequest(QXmlStreamReader &xml);
+    QList<QSharedPointer<OBSRequest>> parseRequestList(OBSXmlStream &stream);
+    void parseProjectEntries(QXmlStreamReader &xml, const QString &userHome, QStringList &list);
+    void startStream(QSharedPointer<OBSXmlStream> stream);
+    static void feedStream(OBSXmlStream &stream, const QByteArray &boundary);
+    static bool hasStreamError(const OBSXmlStream &stream);
+    static bool readNext(QXmlStreamReader &xml);
+    bool parseResultSet(QXmlStreamReader &xml, OBSResultSet &resultSet, QString &state);
     QStringList parseList(QXmlStreamReader &xml);
     void parseMetaConfig(QXmlStreamReader &xml, QSharedPointer<OBSMetaConfig> metaConfig);
     QHash<QString, bool> parseRepositoryFlags(QXmlStreamReader &xml);
     QSharedPointer<OBSDistribution> parseDistribution(QXmlStreamReader &xml);
-    QString requestNumber;
 
 signals:
     void finishedParsingPackage(QSharedPointer<OBSStatus> status, int row);
@@ -108,29 +194,33 @@ signals:
     void finishedParsingDeletePrjStatus(QSharedPointer<OBSStatus> status);
     void finishedParsingDeletePkgStatus(QSharedPointer<OBSStatus> status);
     void finishedParsingDeleteFileStatus(QSharedPointer<OBSStatus> status);
-    void finishedParsingResult(QSharedPointer<OBSResult> result);
-    void finishedParsingResultList(QList<QSharedPointer<OBSResult>> resultList);
-    void finishedParsingRevision(QSharedPointer<OBSRevision> revision);
+    void finishedParsingResults(OBSResultSet resultSet);
+    void finishedParsingResultList(OBSResultSet resultSet);
+    void finishedParsingProjectResultList(const QString &project, OBSResultSet resultSet, const QString &state);
+    void finishedParsingWatchedResults(const QString &resource, OBSResultSet resultSet, const QString &state);
+    void finishedParsingBuildResults(const QString &project, OBSResultSet resultSet, int token);
+    void finishedParsingBuildResultList(const QString &project, int token);
+    void finishedParsingRevisions(QList<QSharedPointer<OBSRevision>> revisionList);
     void finishedParsingLatestRevision(QSharedPointer<OBSRevision> revision);
-    void finishedParsingIncomingRequest(QSharedPointer<OBSRequest> request);
-    void finishedParsingIncomingRequestList();
-    void finishedParsingOutgoingRequest(QSharedPointer<OBSRequest> request);
-    void finishedParsingOutgoingRequestList();
-    void finishedParsingDeclinedRequest(QSharedPointer<OBSRequest> request);
-    void finishedParsingDeclinedRequestList();
+    void finishedParsingIncomingRequests(QList<QSharedPointer<OBSRequest>> requestList);
+    void finishedParsingIncomingRequestList(int count);
+    void finishedParsingOutgoingRequests(QList<QSharedPointer<OBSRequest>> requestList);
+    void finishedParsingOutgoingRequestList(int count);
+    void finishedParsingDeclinedRequests(QList<QSharedPointer<OBSRequest>> requestList);
+    void finishedParsingDeclinedRequestList(int count);
     void finishedParsingList(const QStringList &list);
     void finishedParsingProjectList(const QStringList &projectList);
-    void projectFetched(const QString &project);
+    void projectsFetched(const QStringList &projectList);
     void finishedParsingProjectMetaConfig(QSharedPointer<OBSPrjMetaConfig> prjMetaConfig);
     void finishedParsingPackageMetaConfig(QSharedPointer<OBSPkgMetaConfig> pkgMetaConfig);
     void finishedParsingPackageList(QStringList);
-    void finishedParsingFile(QSharedPointer<OBSFile> file);
+    void finishedParsingFiles(QList<QSharedPointer<OBSFile>> fileList);
     void finishedParsingFileList(const QString &project, const QString &package);
     void finishedParsingRevisionList(const QString &project, const QString &package);
     void finishedParsingLink(QSharedPointer<OBSLink> link);
     void finishedParsingRequestStatus(QSharedPointer<OBSStatus> status);
     void finishedParsingPackageSearch(const QStringList &results);
-    void finishedParsingRequest(QSharedPointer<OBSRequest> request);
+    void finishedParsingRequests(QList<QSharedPointer<OBSRequest>> requestList);
     void finishedParsingRequestList(const QString &project, const QString &package);
     void finishedParsingAbout(QSharedPointer<OBSAbout> about);
     void finishedParsingPerson(QSharedPointer<OBSPerson> person);
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "obsxmltoken.h"
+#include <QLatin1String>
+
+OBSXmlToken::Name OBSXmlToken::fromName(QStringView name)
+{
+    switch (name.size()) {
+    case 4:
+        if (name == QLatin1String("data")) {
+            return Data;
+        } else if (name == QLatin1String("time")) {
+            return Time;
+        } else if (name == QLatin1String("user")) {
+            return User;
+        }
+        break;
+    case 5:
+        if (name == QLatin1String("entry")) {
+            return Entry;
+        } else if (name == QLatin1String("state")) {
+            return State;
+        }
+        break;
+    case 6:
+        if (name == QLatin1String("status")) {
+            return Status;
+        } else if (name == QLatin1String("result")) {
+            return Result;
+        } else if (name == QLatin1String("action")) {
+            return Action;
+        } else if (name == QLatin1String("source")) {
+            return Source;
+        } else if (name == QLatin1String("target")) {
+            return Target;
+        }
+        break;
+    case 7:
+        if (name == QLatin1String("details")) {
+            return Details;
+        } else if (name == QLatin1String("summary")) {
+            return Summary;
+        } else if (name == QLatin1String("request")) {
+            return Request;
+        } else if (name == QLatin1String("version")) {
+            return Version;
+        } else if (name == QLatin1String("comment")) {
+            return Comment;
+        } else if (name == QLatin1String("package")) {
+            return Package;
+        } else if (name == QLatin1String("jobhist")) {
+            return JobHist;
+        }
+        break;
+    case 8:
+        if (name == QLatin1String("revision")) {
+            return Revision;
+        }
+        break;
+    case 10:
+        if (name == QLatin1String("resultlist")) {
+            return ResultList;
+        } else if (name == QLatin1String("collection")) {
+            return Collection;
+        } else if (name == QLatin1String("repository")) {
+            return Repository;
+        }
+        break;
+    case 11:
+        if (name == QLatin1String("description")) {
+            return Description;
+        }
+        break;
+    case 12:
+        if (name == QLatin1String("revisionlist")) {
+            return RevisionList;
+        }
+        break;
+    default:
+        break;
+    }
+    return Unknown;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2025 Javier Llorente <javier@opensuse.org>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef OBSXMLTOKEN_H
+#define OBSXMLTOKEN_H
+
+#include <QStringView>
+
+/*
+ * Names of the elements the list parsers dispatch on.
+ *
+ * fromName() maps the name of the current token to a Name once, by
+ * comparing it (without copying it) only against the names with the
+ * same length. Parsers then switch on the Name instead of comparing
+ * xml.name().toString() with each element they know about.
+ *
+ */
+class OBSXmlToken
+{
+public:
+    enum Name {
+        Unknown,
+        Action,
+        Collection,
+        Comment,
+        Data,
+        Description,
+        Details,
+        Entry,
+        JobHist,
+        Package,
+        Repository,
+        Request,
+        Result,
+        ResultList,
+        Revision,
+        RevisionList,
+        Source,
+        State,
+        Status,
+        Summary,
+        Target,
+        Time,
+        User,
+        Version
+    };
+    static Name fromName(QStringView name);
+
+private:
+    OBSXmlToken();
+};
+
+#endif // OBSXMLTOKEN_H